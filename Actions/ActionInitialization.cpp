@@ -23,18 +23,26 @@
 
 ActionInitialization::ActionInitialization() : G4VUserActionInitialization() {}
 
-ActionInitialization::~ActionInitialization() {}
+ActionInitialization::~ActionInitialization() { delete fMasterGenerator; }
 
 // cppcheck-suppress unusedFunction
-void ActionInitialization::BuildForMaster() const {}
+void ActionInitialization::BuildForMaster() const
+{
+  //! Master does not track events - it seeds the workers, merges their output and reports the run statistics
+  SetUserAction(new RunAction(new HistoManager()));
+  if (!fMasterGenerator) {
+    fMasterGenerator = new PrimaryGeneratorAction(nullptr);
+  }
+}
 
 // cppcheck-suppress unusedFunction
 void ActionInitialization::Build() const
 {
   HistoManager* histo = new HistoManager();
-  SetUserAction(new EventAction(histo));
+  EventAction* eventAction = new EventAction(histo);
+  SetUserAction(eventAction);
   SetUserAction(new RunAction(histo));
   SetUserAction(new PrimaryGeneratorAction(histo));
   SetUserAction(new TrackingAction);
-  SetUserAction(new SteppingAction(histo));
+  SetUserAction(new SteppingAction(histo, eventAction));
 }
@@ -18,6 +18,8 @@
 
 #include <G4VUserActionInitialization.hh>
 
+class PrimaryGeneratorAction;
+
 /**
  * @class ActionInitialization
  * @brief function inherited from GEANT4; be careful while implementing multithread mode
@@ -31,6 +33,10 @@ public:
   virtual void BuildForMaster() const;
   //! Functions called for each thread
   virtual void Build() const;
+
+private:
+  //! Master copy of the generator, only registers /jpetmc/source/ commands before workers start
+  mutable PrimaryGeneratorAction* fMasterGenerator = nullptr;
 };
 
 #endif /* !ACTIONINITIALIZATION_H */
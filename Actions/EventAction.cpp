@@ -14,17 +14,29 @@
  */
 
 #include "../Info/PrimaryParticleInformation.h"
+#include "../Core/DetectorConstruction.h"
 #include "../Objects/Geant4/DetectorHit.h"
 #include "../Objects/Geant4/Trajectory.h"
+#include "../Core/EventSeeder.h"
 #include "EventAction.h"
 
 #include <G4TrajectoryContainer.hh>
 #include <G4ParticleDefinition.hh>
 #include <G4PrimaryParticle.hh>
-#include <G4EventManager.hh>
 #include <G4SDManager.hh>
 #include <G4Event.hh>
 #include "G4RunManager.hh"
+#include <ctime>
+
+namespace {
+  //! CPU time used by the calling thread, in seconds
+  G4double GetThreadCPUTime()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + 1.e-9 * ts.tv_nsec;
+  }
+}
 
 EventAction::EventAction() : is2gRec(false), is3gRec(false)
 {}
@@ -35,7 +47,7 @@ EventAction::EventAction(HistoManager* histo) : G4UserEventAction(), fHistoManag
 EventAction::~EventAction() {}
 
 // cppcheck-suppress unusedFunction
-void EventAction::BeginOfEventAction(const G4Event*)
+void EventAction::BeginOfEventAction(const G4Event* anEvent)
 {
   G4SDManager* SDman = G4SDManager::GetSDMpointer();
   if (fScinCollID < 0) {
@@ -43,39 +55,93 @@ void EventAction::BeginOfEventAction(const G4Event*)
     fScinCollID = SDman->GetCollectionID(colNam = "detectorCollection");
   }
   fHistoManager->Clear();
+  fAbortCause = AbortCause::None;
+
+  //! Event with a gamma leaving the world is not tracked at all, it is only counted; in the approximate
+  //! mode it includes events, in which that gamma would scatter in the chamber, target or frame
+  if (fEvtMessenger->KillEventsEscapingWorld() && fEvtMessenger->UseAcceptanceFilter()
+    && !DetectorConstruction::GetInstance()->GetAcceptanceFilter().IsAccepted(
+      anEvent, fFilterNavigator, fEvtMessenger->IsAcceptanceFilterApproximate()
+    )) {
+    SetAbortCause(AbortCause::AcceptanceFilter);
+    G4RunManager::GetRunManager()->AbortEvent();
+    return;
+  }
+
+  if (!fEvtMessenger->Save2g() && !fEvtMessenger->Save3g()) return;
+  G4int runID = G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID();
+  if (runID != fAbortStatRunID) {
+    fAbortStatRunID = runID;
+    fTrackedEvents = 0;
+    fTrackedCPUTime = 0.0;
+    fEarlyAbortedEvents = 0;
+    fEarlyAbortedCPUTime = 0.0;
+  }
+  fEventStartCPUTime = GetThreadCPUTime();
+
+  //! Event without the requested decay can not be registered - it is not tracked at all
+  bool is2gGen = false;
+  bool is3gGen = false;
+  for (int i = 0; i < anEvent->GetNumberOfPrimaryVertex(); i++) {
+    VtxInformation* info = dynamic_cast<VtxInformation*>(anEvent->GetPrimaryVertex(i)->GetUserInformation());
+    if (info != nullptr) {
+      is2gGen = is2gGen || info->GetTwoGammaGen();
+      is3gGen = is3gGen || info->GetThreeGammaGen();
+    }
+  }
+  if ((fEvtMessenger->Save2g() && !is2gGen) || (fEvtMessenger->Save3g() && !is3gGen)) {
+    SetAbortCause(AbortCause::DecayMissing);
+    G4RunManager::GetRunManager()->AbortEvent();
+  }
 }
 
 // cppcheck-suppress unusedFunction
 void EventAction::EndOfEventAction(const G4Event* anEvent)
 {
   if (anEvent->GetNumberOfPrimaryVertex() == 0) return;
-  if (fEvtMessenger->KillEventsEscapingWorld()) {
-    if (G4EventManager::GetEventManager()->GetNonconstCurrentEvent()->IsAborted()) {
-      return;
+
+  if (fEvtMessenger->Save2g() || fEvtMessenger->Save3g()) {
+    G4double cpuTime = GetThreadCPUTime() - fEventStartCPUTime;
+    //! Event aborted in flight - one of the required gamma quanta was lost
+    if (fAbortCause == AbortCause::RequiredGammaLost) {
+      fEarlyAbortedEvents++;
+      fEarlyAbortedCPUTime += cpuTime;
+      fMetrics->AddTime(fAbortedInFlightTime, cpuTime);
+    } else if (!anEvent->IsAborted()) {
+      fTrackedEvents++;
+      fTrackedCPUTime += cpuTime;
+      fMetrics->AddTime(fTrackedTime, cpuTime);
     }
   }
 
-  if (fEvtMessenger->Save2g()) {
+  if (!anEvent->IsAborted() && fEvtMessenger->Save2g()) {
     CheckIf2gIsRegistered(anEvent);
     if ( ! Is2gRegistered() ) {
+      SetAbortCause(AbortCause::NotRegistered);
       G4RunManager::GetRunManager()->AbortEvent();
     }
   }
 
-  if (fEvtMessenger->Save3g()) {
+  if (!anEvent->IsAborted() && fEvtMessenger->Save3g()) {
     CheckIf3gIsRegistered(anEvent);
     if ( ! Is3gRegistered() ) {
+      SetAbortCause(AbortCause::NotRegistered);
       G4RunManager::GetRunManager()->AbortEvent();
     }
   }
 
+  if (anEvent->IsAborted()) {
+    CountAbortedEvent();
+    return;
+  }
   WriteToFile(anEvent);
+  fMetrics->Add(fStoredEvents);
 }
 
 void EventAction::WriteToFile(const G4Event* anEvent)
 {
   //! save information about generated events
-  G4int id = anEvent->GetEventID();
+  G4long id = EventSeeder::GetGlobalEventID(anEvent->GetEventID());
   fHistoManager->SetEventNumber(id);
   fHistoManager->FillHistoGenInfo(anEvent);
 
@@ -101,6 +167,50 @@ void EventAction::WriteToFile(const G4Event* anEvent)
   fHistoManager->SaveEvtPack();
 }
 
+/**
+ * Only events killed by saveEvtsDetAcc (escaping gamma or the acceptance filter) are rejected
+ * events used for normalization; events aborted by save2g/save3g are counted as unselected
+ */
+void EventAction::CountAbortedEvent()
+{
+  switch (fAbortCause) {
+    case AbortCause::EscapedWorld:
+    case AbortCause::AcceptanceFilter:
+      fHistoManager->AddRejectedEvent(fAbortCause == AbortCause::AcceptanceFilter);
+      fMetrics->Add(fRejectedEvents);
+      if (fAbortCause == AbortCause::AcceptanceFilter) fMetrics->Add(fRejectedBeforeTrackingEvents);
+      break;
+    case AbortCause::DecayMissing:
+      fHistoManager->AddUnselectedEvent();
+      fMetrics->Add(fDecayMissingEvents);
+      break;
+    case AbortCause::RequiredGammaLost:
+      fHistoManager->AddUnselectedEvent();
+      fMetrics->Add(fAbortedInFlightEvents);
+      break;
+    case AbortCause::NotRegistered:
+      fHistoManager->AddUnselectedEvent();
+      fMetrics->Add(fNotRegisteredEvents);
+      break;
+    case AbortCause::None:
+      break;
+  }
+}
+
+void EventAction::PrintEarlyAbortStatistics() const
+{
+  if (fEarlyAbortedEvents == 0) return;
+  G4cout << "\n----> Early abort: " << fEarlyAbortedEvents << " events aborted in flight, "
+    << fTrackedEvents << " tracked to the end" << G4endl;
+  if (fTrackedEvents > 0) {
+    //! Aborted event would otherwise cost on average as much as an event tracked to the end
+    G4double meanTracked = fTrackedCPUTime / fTrackedEvents;
+    G4double saved = fEarlyAbortedEvents * meanTracked - fEarlyAbortedCPUTime;
+    G4cout << "----> CPU saved: " << saved << " s (" << 1.e3 * saved / fEarlyAbortedEvents
+      << " ms per aborted event, " << 1.e3 * meanTracked << " ms per tracked event)" << G4endl;
+  }
+}
+
 bool EventAction::Is2gRegistered()
 {
   return is2gRec;
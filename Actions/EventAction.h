@@ -20,8 +20,10 @@
 #include "../Objects/Framework/JPetGeantScinHits.h"
 #include "../Info/EventMessenger.h"
 #include "../Core/HistoManager.h"
+#include "../Core/RunMetrics.h"
 
 #include <G4UserEventAction.hh>
+#include <G4Navigator.hh>
 #include <globals.hh>
 #include <memory>
 
@@ -40,20 +42,55 @@ public:
   virtual ~EventAction();
   virtual void BeginOfEventAction(const G4Event*);
   virtual void EndOfEventAction(const G4Event* anEvent);
+  //! Reason of aborting the event, each one is counted separately
+  enum class AbortCause {
+    None,
+    EscapedWorld,
+    AcceptanceFilter,
+    DecayMissing,
+    RequiredGammaLost,
+    NotRegistered
+  };
+  //! Only the first abort of the event is recorded
+  void SetAbortCause(AbortCause cause) { if (fAbortCause == AbortCause::None) fAbortCause = cause; };
   bool Is2gRegistered();
   bool Is3gRegistered();
+  //! Summary of events aborted in flight by save2g/save3g with the estimated CPU time saved
+  void PrintEarlyAbortStatistics() const;
 
 private:
   HistoManager* fHistoManager = nullptr;
   G4int fScinCollID;
   EventMessenger* fEvtMessenger = EventMessenger::GetEventMessenger();
   void WriteToFile(const G4Event* anEvent);
+  //! Adds the aborted event to the counters of its cause
+  void CountAbortedEvent();
 
+  AbortCause fAbortCause = AbortCause::None;
+  //! Follows the gamma quanta missing the barrel to the world boundary, separate from the tracking navigator
+  G4Navigator fFilterNavigator;
   bool is2gRec;
   bool is3gRec;
   void CheckIf3gIsRegistered(const G4Event* anEvent);
   void CheckIf2gIsRegistered(const G4Event* anEvent);
 
+  //! Thread CPU time of events tracked to the end and aborted in flight, for the current run
+  G4int fAbortStatRunID = -1;
+  G4double fEventStartCPUTime = 0.0;
+  G4long fTrackedEvents = 0;
+  G4double fTrackedCPUTime = 0.0;
+  G4long fEarlyAbortedEvents = 0;
+  G4double fEarlyAbortedCPUTime = 0.0;
+
+  RunMetrics* fMetrics = RunMetrics::GetInstance();
+  MetricHandle fStoredEvents = fMetrics->Counter("events.stored");
+  MetricHandle fRejectedEvents = fMetrics->Counter("events.rejected");
+  MetricHandle fRejectedBeforeTrackingEvents = fMetrics->Counter("events.rejectedBeforeTracking");
+  MetricHandle fDecayMissingEvents = fMetrics->Counter("events.decayMissing");
+  MetricHandle fAbortedInFlightEvents = fMetrics->Counter("events.abortedInFlight");
+  MetricHandle fNotRegisteredEvents = fMetrics->Counter("events.notRegistered");
+  MetricHandle fTrackedTime = fMetrics->Timer("cpu.trackedEvents");
+  MetricHandle fAbortedInFlightTime = fMetrics->Timer("cpu.abortedInFlightEvents");
 };
 
 #endif /* !EVENTACTION_H */
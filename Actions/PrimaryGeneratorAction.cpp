@@ -14,9 +14,12 @@
  */
 
 #include "../Core/DetectorConstruction.h"
+#include "../Core/EventSeeder.h"
 #include "PrimaryGeneratorAction.h"
 
 #include <G4PrimaryVertex.hh>
+#include <G4RunManager.hh>
+#include <G4Run.hh>
 
 PrimaryGeneratorAction::PrimaryGeneratorAction() {}
 
@@ -53,6 +56,20 @@ void PrimaryGeneratorAction::SetEffectivePositronRadius(G4double radius)
 // cppcheck-suppress unusedFunction
 void PrimaryGeneratorAction::GeneratePrimaries(G4Event* event)
 {
+  //! Killed events are generated again with the same ID, each attempt gets its own seed
+  G4int runID = G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID();
+  if (runID != fLastRunID) {
+    fPrimaryGenerator->ResetStatistics();
+  }
+  if (event->GetEventID() == fLastEventID && runID == fLastRunID) {
+    fAttempt++;
+  } else {
+    fAttempt = 0;
+  }
+  fLastEventID = event->GetEventID();
+  fLastRunID = runID;
+  EventSeeder::SeedEvent(event->GetEventID(), fAttempt);
+
   //! if setup for dedicated run is set then ignore its modifications made by user
   G4int nRun = DetectorConstruction::GetInstance()->GetRunNumber();
   if (nRun != 0) {
@@ -50,6 +50,9 @@ public:
   void SetNemaPoint(G4int i) { fNemaPoint = i; }
   G4int GetNemaPoint() { return fNemaPoint; }
   void SetEffectivePositronRadius(G4double);
+  void SetThreeGammaTable(G4bool tf) { fPrimaryGenerator->SetThreeGammaTable(tf); }
+  void SetBoundaryVertexSearch(G4bool tf) { fPrimaryGenerator->SetBoundaryVertexSearch(tf); }
+  const PrimaryGenerator* GetPrimaryGenerator() const { return fPrimaryGenerator; }
 
 private:
   G4String fGenerateSourceType;
@@ -61,6 +64,10 @@ private:
   SourceParams* fIsotope = nullptr;
   G4int fNemaPoint = -1;
   G4double fEffectivePositronRadius = 0.5 * cm;
+  //! Event generated last time and number of its repeated generations
+  G4int fLastEventID = -1;
+  G4int fLastRunID = -1;
+  G4int fAttempt = 0;
 };
 
 #endif /* !PRIMARYGENERATORACTION_H */
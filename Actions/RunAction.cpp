@@ -13,14 +13,20 @@
  *  @file RunAction.cpp
  */
 
+#include "../Core/ProgressReporter.h"
+#include "../Core/EventSeeder.h"
+#include "../Core/RunMetrics.h"
+#include "PrimaryGeneratorAction.h"
+#include "EventAction.h"
 #include "RunAction.h"
 
 #include <G4SystemOfUnits.hh>
+#include <G4RunManager.hh>
 #include <G4UnitsTable.hh>
+#include <G4Threading.hh>
 #include <Randomize.hh>
-#include <TRandom3.h>
 #include <G4Run.hh>
-#include <chrono>
+#include <algorithm>
 
 RunAction::RunAction() {}
 
@@ -29,32 +35,72 @@ RunAction::RunAction(HistoManager* histo) : G4UserRunAction(), fHistoManager(his
 RunAction::~RunAction() {}
 
 // cppcheck-suppress unusedFunction
-void RunAction::BeginOfRunAction(const G4Run*)
+void RunAction::BeginOfRunAction(const G4Run* run)
 {
-  fHistoManager->Book();
-
-  int mask = 01001010;
-
-  if (fEvtMessenger->GetSeed() == 0) {
-    /**
-     * If seed 0 is used we are seeding random generator with a number which is a
-     * combination of current time and process PID. Bu doing so seed is unique in
-     * time and space.
-     * Number 667 (123th prime number) is chosen to secure that different processes
-     * run at the same time don't have seeds that are close to each other - otherwise
-     * it may cause random nummber sequences to be also close to each other.
-     *
-     */
-    using namespace std::chrono;
-    system_clock::time_point now = system_clock::now();
-    long seed = (UInt_t)(system_clock::to_time_t(now)) * 677 * ::getpid();
-    G4Random::setTheSeed(seed);
-    gRandom->SetSeed(seed ^ mask);
-  } else {
-    gRandom->SetSeed(fEvtMessenger->GetSeed());
-    G4Random::setTheSeed(fEvtMessenger->GetSeed() ^ mask);
+  if (fHistoManager) {
+    fHistoManager->Book();
+  }
+  RunMetrics::GetInstance()->Reset();
+
+  //! In multithreaded mode workers are seeded by the master
+  if (!G4Threading::IsMasterThread()) {
+    return;
+  }
+  fTimer.Start();
+  RunMetrics::StartRun(run->GetRunID(), run->GetNumberOfEventToBeProcessed());
+  if (fEvtMessenger->ShowProgress()) {
+    ProgressReporter::GetInstance()->Start(run->GetNumberOfEventToBeProcessed(), fEvtMessenger->GetProgressInterval());
+  }
+
+  //! Events are seeded separately from the run seed, see EventSeeder
+  EventSeeder::SetRunSeed(fEvtMessenger->GetSeed());
+  G4Random::setTheSeed(EventSeeder::GetRunSeed());
+  //! Every shard of a campaign covers its own range of event IDs
+  EventSeeder::SetEventOffset(
+    static_cast<G4long>(fEvtMessenger->GetShardIndex()) * run->GetNumberOfEventToBeProcessed()
+  );
+  G4cout << "\n----> Run seed: " << EventSeeder::GetRunSeed() << G4endl;
+  if (fEvtMessenger->IsSharded()) {
+    G4cout << "----> Shard " << fEvtMessenger->GetShardIndex() << "/" << fEvtMessenger->GetShardCount()
+      << ": events " << EventSeeder::GetEventOffset() << " - "
+      << EventSeeder::GetEventOffset() + run->GetNumberOfEventToBeProcessed() - 1 << G4endl;
   }
 }
 
 // cppcheck-suppress unusedFunction
-void RunAction::EndOfRunAction(const G4Run*) { fHistoManager->Save(); }
+void RunAction::EndOfRunAction(const G4Run* run)
+{
+  if (fHistoManager) {
+    fHistoManager->Save();
+  }
+
+  //! Event and primary generator actions exist only on threads tracking the events
+  const EventAction* eventAction =
+    dynamic_cast<const EventAction*>(G4RunManager::GetRunManager()->GetUserEventAction());
+  if (eventAction) {
+    eventAction->PrintEarlyAbortStatistics();
+  }
+  const PrimaryGeneratorAction* generatorAction =
+    dynamic_cast<const PrimaryGeneratorAction*>(G4RunManager::GetRunManager()->GetUserPrimaryGeneratorAction());
+  if (generatorAction) {
+    generatorAction->GetPrimaryGenerator()->PrintStatistics();
+  }
+
+  if (!G4Threading::IsMasterThread()) {
+    return;
+  }
+  fTimer.Stop();
+  if (fEvtMessenger->ShowProgress()) {
+    ProgressReporter::GetInstance()->Finish();
+  }
+  G4double realTime = fTimer.GetRealElapsed();
+  G4int nThreads = std::max(1, G4Threading::GetNumberOfRunningWorkerThreads());
+  G4cout << "\n----> Run " << run->GetRunID() << ": " << run->GetNumberOfEventToBeProcessed()
+    << " events (" << run->GetNumberOfEvent() << " generated) in " << realTime << " s using "
+    << nThreads << " thread(s)" << G4endl;
+  if (realTime > 0) {
+    G4cout << "----> Throughput: " << run->GetNumberOfEventToBeProcessed() / realTime
+      << " events/s, " << run->GetNumberOfEventToBeProcessed() / realTime / nThreads
+      << " events/s per thread\n" << G4endl;
+  }
+}
@@ -19,6 +19,7 @@
 #include "../Core/HistoManager.h"
 
 #include <G4UserRunAction.hh>
+#include <G4Timer.hh>
 #include <globals.hh>
 
 class G4Run;
@@ -39,6 +40,8 @@ public:
 private:
   HistoManager* fHistoManager = nullptr;
   EventMessenger* fEvtMessenger = EventMessenger::GetEventMessenger();
+  //! Wall time of the run measured on the master
+  G4Timer fTimer;
 };
 
 #endif /* !RUNACTION_H */
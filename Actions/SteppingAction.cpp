@@ -22,7 +22,8 @@
 #include <G4RunManager.hh>
 #include <G4UImanager.hh>
 
-SteppingAction::SteppingAction(HistoManager* histo) : fHistoManager(histo)
+SteppingAction::SteppingAction(HistoManager* histo, EventAction* eventAction) :
+fHistoManager(histo), fEventAction(eventAction)
 {
   G4TransportationManager::GetTransportationManager()
   ->GetNavigatorForTracking()->SetPushVerbosity(0);
@@ -33,6 +34,8 @@ SteppingAction::~SteppingAction() {}
 // cppcheck-suppress unusedFunction
 void SteppingAction::UserSteppingAction(const G4Step* aStep)
 {
+  fMetrics->Add(fSteps);
+
   //! Primary particles, that escape the world volume without interaction
   //! are not regeistered, if proper macro option was set -
   //! done in order to optimize simulation time
@@ -56,13 +59,28 @@ void SteppingAction::UserSteppingAction(const G4Step* aStep)
             && (multiplicity <= maxBoundMultiplicity)
             && (multiplicity != excludedMultiplicity)
           ) {
+            fEventAction->SetAbortCause(EventAction::AbortCause::EscapedWorld);
             G4RunManager::GetRunManager()->AbortEvent();
           }
         }
       }
     }
   }
-  
+
+  RegisterInteractionInNonActivePart(aStep);
+
+  //! Events selected with save2g/save3g are aborted as soon as one of the
+  //! required gamma quanta can no longer be registered
+  if (EventMessenger::GetEventMessenger()->Save2g() || EventMessenger::GetEventMessenger()->Save3g()) {
+    if (IsRequiredGammaLost(aStep)) {
+      fEventAction->SetAbortCause(EventAction::AbortCause::RequiredGammaLost);
+      G4RunManager::GetRunManager()->AbortEvent();
+    }
+  }
+}
+
+void SteppingAction::RegisterInteractionInNonActivePart(const G4Step* aStep)
+{
   //! execute code for
   //! - generated by user gamma quanta
   //! - physical effects that does not occur in Sensitive Detector
@@ -93,3 +111,32 @@ void SteppingAction::UserSteppingAction(const G4Step* aStep)
     }
   }
 }
+
+G4bool SteppingAction::IsRequiredGammaLost(const G4Step* aStep) const
+{
+  const G4Track* track = aStep->GetTrack();
+  if (track->GetParentID() != 0) {
+    return false;
+  }
+  PrimaryParticleInformation* info = dynamic_cast<PrimaryParticleInformation*>(
+    track->GetDynamicParticle()->GetPrimaryParticle()->GetUserInformation()
+  );
+  if (info == nullptr || info->IsRegistered()) {
+    return false;
+  }
+  G4int generated = info->GetGeneratedGammaMultiplicity();
+  G4bool isRequired =
+    (EventMessenger::GetEventMessenger()->Save2g() && generated == PrimaryParticleInformation::kBackToBackGamma)
+    || (EventMessenger::GetEventMessenger()->Save3g() && generated == PrimaryParticleInformation::koPsGamma);
+  if (!isRequired) {
+    return false;
+  }
+  //! Hit is registered only with unchanged multiplicity, so a gamma scattered
+  //! outside the scintillators (or without energy deposition) is already lost
+  if (info->GetGammaMultiplicity() != generated) {
+    return true;
+  }
+  return aStep->GetPostStepPoint()->GetStepStatus() == G4StepStatus::fWorldBoundary
+    || track->GetTrackStatus() == fStopAndKill
+    || track->GetTrackStatus() == fKillTrackAndSecondaries;
+}
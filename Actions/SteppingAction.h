@@ -17,18 +17,30 @@
 #define STEPPINGACTION_H 1
 
 #include "../Core/HistoManager.h"
+#include "../Core/RunMetrics.h"
+#include "EventAction.h"
 
 #include <G4UserSteppingAction.hh>
 
 class SteppingAction : public G4UserSteppingAction
 {
 public:
-  explicit SteppingAction(HistoManager*);
+  SteppingAction(HistoManager* histo, EventAction* eventAction);
   ~SteppingAction();
   virtual void UserSteppingAction(const G4Step*);
   
 private:
+  //! Marks primary gamma quanta interacting outside the sensitive detector
+  void RegisterInteractionInNonActivePart(const G4Step* aStep);
+  //! True if a primary gamma required by save2g/save3g can no longer give a registered hit
+  G4bool IsRequiredGammaLost(const G4Step* aStep) const;
+
   HistoManager* fHistoManager = nullptr;
+  //! Receives the cause of aborting the event
+  EventAction* fEventAction = nullptr;
+  RunMetrics* fMetrics = RunMetrics::GetInstance();
+  //! Compared with the run wall time by the navigation benchmarks
+  MetricHandle fSteps = fMetrics->Counter("steps");
 };
 
 #endif /* !STEPPINGACTION_H */
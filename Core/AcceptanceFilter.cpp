@@ -0,0 +1,142 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file AcceptanceFilter.cpp
+ */
+
+#include "../Info/PrimaryParticleInformation.h"
+#include "../Info/EventMessenger.h"
+#include "AcceptanceFilter.h"
+
+#include <G4TransportationManager.hh>
+#include <G4PrimaryParticle.hh>
+#include <G4PrimaryVertex.hh>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace {
+  //! Range of t for which |p + t d| < r in the transverse plane; false if the ray does not enter the circle
+  bool crossCircle(const G4ThreeVector& p, const G4ThreeVector& d, G4double r, G4double& tMin, G4double& tMax)
+  {
+    G4double a = d.perp2();
+    G4double b = p.x() * d.x() + p.y() * d.y();
+    G4double c = p.perp2() - r * r;
+    G4double delta = b * b - a * c;
+    if (delta <= 0.0) return false;
+    G4double sqrtDelta = std::sqrt(delta);
+    tMin = (-b - sqrtDelta) / a;
+    tMax = (-b + sqrtDelta) / a;
+    return true;
+  }
+}
+
+void AcceptanceFilter::AddLayer(G4double innerRadius, G4double outerRadius, G4double halfLength)
+{
+  fLayers.push_back({innerRadius, outerRadius, halfLength});
+}
+
+G4bool AcceptanceFilter::IsReachable(const G4ThreeVector& vertex, const G4ThreeVector& direction) const
+{
+  for (const Shell& shell : fLayers) {
+    if (IsReachable(shell, vertex, direction)) return true;
+  }
+  return false;
+}
+
+/**
+ * Ray p + t d (t >= 0) has to pass through r in [inner, outer] with |z| <= half length.
+ * Interval of t inside the outer cylinder and the z range is found first,
+ * the ray reaches the shell unless this interval lies wholly inside the inner cylinder.
+ */
+G4bool AcceptanceFilter::IsReachable(
+  const Shell& shell, const G4ThreeVector& vertex, const G4ThreeVector& direction
+) const {
+  G4double tLow = 0.0;
+  G4double tHigh = DBL_MAX;
+  if (direction.z() != 0.0) {
+    G4double t1 = (-shell.fHalfLength - vertex.z()) / direction.z();
+    G4double t2 = (shell.fHalfLength - vertex.z()) / direction.z();
+    tLow = std::max(tLow, std::min(t1, t2));
+    tHigh = std::min(tHigh, std::max(t1, t2));
+  } else if (std::abs(vertex.z()) > shell.fHalfLength) {
+    return false;
+  }
+
+  if (direction.perp2() == 0.0) {
+    G4double r = vertex.perp();
+    return tLow <= tHigh && r >= shell.fInnerRadius && r <= shell.fOuterRadius;
+  }
+  G4double tOuterMin, tOuterMax;
+  if (!crossCircle(vertex, direction, shell.fOuterRadius, tOuterMin, tOuterMax)) return false;
+  tLow = std::max(tLow, tOuterMin);
+  tHigh = std::min(tHigh, tOuterMax);
+  if (tLow > tHigh) return false;
+
+  G4double tInnerMin, tInnerMax;
+  if (!crossCircle(vertex, direction, shell.fInnerRadius, tInnerMin, tInnerMax)) return true;
+  return tLow < tInnerMin || tHigh > tInnerMax;
+}
+
+/**
+ * Ray starts in the world volume, so the first boundary found by the navigator is either
+ * the surface of a daughter volume or the surface of the world
+ */
+G4bool AcceptanceFilter::CrossesOnlyWorld(
+  G4Navigator& navigator, const G4ThreeVector& vertex, const G4ThreeVector& direction
+) const {
+  G4ThreeVector unitDirection = direction.unit();
+  G4VPhysicalVolume* world = navigator.GetWorldVolume();
+  if (navigator.LocateGlobalPointAndSetup(vertex, &unitDirection, false, false) != world) return false;
+  G4double safety = 0.0;
+  G4double toBoundary = navigator.ComputeStep(vertex, unitDirection, kInfinity, safety);
+  G4double toWorldSurface = world->GetLogicalVolume()->GetSolid()->DistanceToOut(vertex, unitDirection);
+  return toBoundary >= toWorldSurface - kCarTolerance;
+}
+
+/**
+ * Gamma escaping the world with unchanged multiplicity kills the event in SteppingAction. Missing
+ * the barrel is not enough for that - the gamma may scatter in the passive materials and be
+ * registered afterwards; only the conservative mode rejects exactly such events (up to scattering
+ * in the material of the world).
+ */
+G4bool AcceptanceFilter::IsAccepted(const G4Event* anEvent, G4Navigator& navigator, G4bool approximate) const
+{
+  if (IsEmpty()) return true;
+  if (!approximate) {
+    navigator.SetWorldVolume(
+      G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume()
+    );
+  }
+  EventMessenger* messenger = EventMessenger::GetEventMessenger();
+  for (G4int i = 0; i < anEvent->GetNumberOfPrimaryVertex(); i++) {
+    G4PrimaryVertex* vertex = anEvent->GetPrimaryVertex(i);
+    for (G4PrimaryParticle* particle = vertex->GetPrimary(); particle; particle = particle->GetNext()) {
+      PrimaryParticleInformation* info = dynamic_cast<PrimaryParticleInformation*>(particle->GetUserInformation());
+      if (info == nullptr) continue;
+      //! Same condition as for killing the event in SteppingAction, for the gamma which does not interact
+      G4int multiplicity = info->GetGammaMultiplicity();
+      if (
+        (multiplicity < messenger->GetMinRegMultiplicity())
+        || (multiplicity > messenger->GetMaxRegMultiplicity())
+        || (multiplicity == messenger->GetExcludedMultiplicity())
+      ) {
+        continue;
+      }
+      if (IsReachable(vertex->GetPosition(), particle->GetMomentumDirection())) continue;
+      if (approximate || CrossesOnlyWorld(navigator, vertex->GetPosition(), particle->GetMomentumDirection())) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
@@ -0,0 +1,57 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file AcceptanceFilter.h
+ */
+
+#ifndef ACCEPTANCEFILTER_H
+#define ACCEPTANCEFILTER_H 1
+
+#include <G4ThreeVector.hh>
+#include <G4Navigator.hh>
+#include <G4Event.hh>
+#include <globals.hh>
+#include <vector>
+
+/**
+ * @class AcceptanceFilter
+ * @brief analytic geometric acceptance of the barrel; rejects events before tracking
+ * when a generated gamma cannot reach any layer of scintillators (used with saveEvtsDetAcc)
+ */
+class AcceptanceFilter
+{
+public:
+  //! Layer approximated by a cylindrical shell enclosing all its strips
+  void AddLayer(G4double innerRadius, G4double outerRadius, G4double halfLength);
+  void Clear() { fLayers.clear(); };
+  bool IsEmpty() const { return fLayers.empty(); };
+  //! True if the ray from the vertex along the direction crosses any of the layers
+  G4bool IsReachable(const G4ThreeVector& vertex, const G4ThreeVector& direction) const;
+  //! False if any primary gamma, which would kill the event when escaping the world, misses the barrel;
+  //! in the conservative mode its straight path to the world boundary has also to cross no volume but
+  //! the world, in the approximate mode scattering in the chamber, target and frame is neglected
+  G4bool IsAccepted(const G4Event* anEvent, G4Navigator& navigator, G4bool approximate) const;
+
+private:
+  struct Shell {
+    G4double fInnerRadius;
+    G4double fOuterRadius;
+    G4double fHalfLength;
+  };
+  G4bool IsReachable(const Shell& shell, const G4ThreeVector& vertex, const G4ThreeVector& direction) const;
+  //! True if the vertex is in the world volume itself and the ray leaves the world before entering any daughter
+  G4bool CrossesOnlyWorld(G4Navigator& navigator, const G4ThreeVector& vertex, const G4ThreeVector& direction) const;
+
+  std::vector<Shell> fLayers;
+};
+
+#endif /* !ACCEPTANCEFILTER_H */
@@ -0,0 +1,84 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file AliasTable.cpp
+ */
+
+#include "AliasTable.h"
+
+/**
+ * Vose's construction: bins with scaled weight below 1 are topped up
+ * by the bins above 1, each bin gets at most one alias.
+ */
+void AliasTable::Build(const std::vector<G4double>& weights)
+{
+  Clear();
+  for (G4double weight : weights) {
+    fTotalWeight += weight;
+  }
+  if (fTotalWeight <= 0.0) {
+    fTotalWeight = 0.0;
+    return;
+  }
+  std::size_t size = weights.size();
+  fWeights = weights;
+  fKeep.resize(size);
+  fAlias.resize(size);
+  std::vector<std::size_t> small;
+  std::vector<std::size_t> large;
+  for (std::size_t i = 0; i < size; i++) {
+    fKeep[i] = weights[i] * size / fTotalWeight;
+    fAlias[i] = i;
+    if (fKeep[i] < 1.0) {
+      small.push_back(i);
+    } else {
+      large.push_back(i);
+    }
+  }
+  while (!small.empty() && !large.empty()) {
+    std::size_t less = small.back();
+    small.pop_back();
+    std::size_t more = large.back();
+    fAlias[less] = more;
+    fKeep[more] -= 1.0 - fKeep[less];
+    if (fKeep[more] < 1.0) {
+      large.pop_back();
+      small.push_back(more);
+    }
+  }
+  //! Remaining bins differ from 1 only by rounding
+  for (std::size_t i : small) fKeep[i] = 1.0;
+  for (std::size_t i : large) fKeep[i] = 1.0;
+}
+
+void AliasTable::Clear()
+{
+  fKeep.clear();
+  fAlias.clear();
+  fWeights.clear();
+  fTotalWeight = 0.0;
+}
+
+G4double AliasTable::GetProbability(std::size_t index) const
+{
+  if (fTotalWeight <= 0.0 || index >= fWeights.size()) return 0.0;
+  return fWeights[index] / fTotalWeight;
+}
+
+std::size_t AliasTable::Sample(G4double uniform) const
+{
+  G4double scaled = uniform * fAlias.size();
+  std::size_t bin = static_cast<std::size_t>(scaled);
+  if (bin >= fAlias.size()) bin = fAlias.size() - 1;
+  //! Fractional part is the second, independent uniform number
+  return (scaled - bin < fKeep[bin]) ? bin : fAlias[bin];
+}
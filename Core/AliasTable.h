@@ -0,0 +1,52 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file AliasTable.h
+ */
+
+#ifndef ALIASTABLE_H
+#define ALIASTABLE_H 1
+
+#include <globals.hh>
+#include <vector>
+
+/**
+ * @class AliasTable
+ * @brief Walker's alias method - draws an index with probability proportional to its weight
+ * in constant time, from a single uniform random number
+ */
+class AliasTable
+{
+public:
+  AliasTable() {}
+  explicit AliasTable(const std::vector<G4double>& weights) { Build(weights); }
+  //! Weights have to be non-negative; table is empty if all of them are zero
+  void Build(const std::vector<G4double>& weights);
+  void Clear();
+  bool IsEmpty() const { return fAlias.empty(); }
+  std::size_t GetSize() const { return fAlias.size(); }
+  //! Sum of the weights the table was built from
+  G4double GetTotalWeight() const { return fTotalWeight; }
+  //! Probability of drawing the index
+  G4double GetProbability(std::size_t index) const;
+  //! uniform in [0, 1)
+  std::size_t Sample(G4double uniform) const;
+
+private:
+  //! Probability of keeping the drawn bin instead of its alias
+  std::vector<G4double> fKeep;
+  std::vector<std::size_t> fAlias;
+  std::vector<G4double> fWeights;
+  G4double fTotalWeight = 0.0;
+};
+
+#endif /* !ALIASTABLE_H */
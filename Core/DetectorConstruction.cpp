@@ -18,6 +18,7 @@
 #include "MaterialParameters.h"
 #include "DetectorConstants.h"
 #include "MaterialExtension.h"
+#include "MeshBodies.h"
 #include "RunManager.h"
 
 #include <boost/property_tree/json_parser.hpp>
@@ -25,17 +26,24 @@
 #include <boost/algorithm/string.hpp>
 #include <G4PhysicalVolumeStore.hh>
 #include <G4LogicalVolumeStore.hh>
+#include <G4IntersectionSolid.hh>
 #include <G4SubtractionSolid.hh>
 #include <boost/optional.hpp>
 #include <G4RegionStore.hh>
+#include <G4Threading.hh>
 #include <G4SolidStore.hh>
 #include <G4Sphere.hh>
 #include <G4UnionSolid.hh>
 #include <G4Polycone.hh>
 #include <G4Tubs.hh>
+#include <algorithm>
 #include <iostream>
+#include <chrono>
 #include <iomanip>
 #include <vector>
+#include <tuple>
+#include <cmath>
+#include <map>
 
 DetectorConstruction* DetectorConstruction::fInstance = 0;
 
@@ -57,7 +65,7 @@ DetectorConstruction::~DetectorConstruction() { delete fMessenger; }
 
 void DetectorConstruction::SetHistoManager(HistoManager* histo)
 {
-  fHistoManager = histo;
+  fHistoManager.Put(histo);
 }
 
 // cppcheck-suppress unusedFunction
@@ -67,6 +75,8 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   G4PhysicalVolumeStore::GetInstance()->Clean();
   G4LogicalVolumeStore::GetInstance()->Clean();
   G4SolidStore::GetInstance()->Clean();
+  auto start = std::chrono::steady_clock::now();
+  fScinInStrip = nullptr;
 
   //! world
   fWorldSolid = new G4Box(
@@ -77,18 +87,31 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   fWorldPhysical = new G4PVPlacement(
     0, G4ThreeVector(), fWorldLogical, "worldPhysical", 0, false, 0, checkOverlaps
   );
-
-  if (fLoadScintillators) {
-    //! scintillators for standard setup
-    ConstructScintillators();
-  }
-  if (fLoadModularLayer) {
-    ConstructScintillatorsModularLayer();
+  fAcceptanceFilter.Clear();
+  fGeometryVersion++;
+  fLayerContainer.clear();
+  fSlotContainer.clear();
+  fScinContainer.clear();
+  fLayerNumber = 0;
+
+  if (fLoadDescription) {
+    ConstructScintillatorsFromDescription();
+  } else {
+    if (fLoadScintillators) {
+      //! scintillators for standard setup
+      ConstructScintillators();
+    }
+    if (fLoadModularLayer) {
+      ConstructScintillatorsModularLayer();
+    }
   }
   if (fLoadCADFrame) {
     ConstructFrameCAD();
   }
-  if (fRunNumber == 3) {
+  if (fLoadDescription) {
+    //! targets of the description, the run number selects only the source
+    ConstructSolidsFromDescription();
+  } else if (fRunNumber == 3) {
     ConstructTargetRun3();
   } else if (fRunNumber == 5) {
     ConstructTargetRun5();
@@ -100,6 +123,14 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
      ConstructTargetRun12();
   }
 
+  G4cout << "\n----> Geometry constructed in "
+    << 1.e3 * std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " ms, "
+    << fWorldLogical->GetNoDaughters() << " volumes placed in the world";
+  if (fLoadDescription) {
+    G4cout << " from " << fDescription.GetFileName();
+  }
+  G4cout << G4endl;
+
   if (fCreateGeometryFile) {
     CreateGeometryFile();
   }
@@ -114,11 +145,18 @@ void DetectorConstruction::ConstructSDandField()
     DetectorSD* det = new DetectorSD(
       "/mydet/detector", maxScinID, DetectorConstants::GetMergingTimeValueForScin()
     );
-    det->SetHistoManager(fHistoManager);
+    det->SetHistoManager(fHistoManager.Get());
     fDetectorSD.Put(det);
   }
+  fDetectorSD.Get()->SetScintillatorInStrip(fScinInStrip);
 
   G4SDManager::GetSDMpointer()->AddNewDetector(fDetectorSD.Get());
+  if (fLoadDescription) {
+    for (G4LogicalVolume* scinLog : fDescriptionScinLogs) {
+      SetSensitiveDetector(scinLog, fDetectorSD.Get());
+    }
+    return;
+  }
   SetSensitiveDetector(fScinLog, fDetectorSD.Get());
   if (fLoadModularLayer) {
     SetSensitiveDetector(fScinLogInModule, fDetectorSD.Get());
@@ -140,13 +178,27 @@ void DetectorConstruction::LoadGeometryForRun(G4int nr)
 // cppcheck-suppress unusedFunction
 G4int DetectorConstruction::ReturnNumberOfScintillators()
 {
+  if (fLoadDescription) return fDescription.fScins.size();
   if (fLoadModularLayer) return 504;
   else return 192;
 }
 
+void DetectorConstruction::LoadGeometryFile(const G4String& fileName)
+{
+  if (fileName == "none") {
+    fLoadDescription = false;
+    return;
+  }
+  fDescription.Read(fileName);
+  fLoadDescription = true;
+}
+
 void DetectorConstruction::UpdateGeometry()
 {
-  RunManager::GetRunManager()->ReinitializeGeometry();
+  //! Geometry is shared by all threads and it is rebuilt only by the master
+  if (G4Threading::IsMasterThread()) {
+    RunManager::GetRunManager()->ReinitializeGeometry();
+  }
 }
 
 void DetectorConstruction::ReloadMaterials(const G4String& material)
@@ -314,24 +366,32 @@ void DetectorConstruction::InitializeMaterials()
  */
 void DetectorConstruction::ConstructFrameCAD()
 {
-  CADMesh* mesh1 = new CADMesh((char*) "stl_geometry/Frame_JPET.stl");
-  mesh1->SetScale(mm);
-
-  G4VSolid* cad_solid1 = mesh1->TessellatedMesh();
-  G4LogicalVolume* cad_logical = new G4LogicalVolume(cad_solid1, fAluminiumMaterial, "cad_logical");
+  G4VSolid* cad_solid1 = fMeshCache.Load("stl_geometry/Frame_JPET.stl", mm, "cad_solid");
+  std::vector<G4VSolid*> cad_solids = {cad_solid1};
+  G4TessellatedSolid* cad_mesh = dynamic_cast<G4TessellatedSolid*>(cad_solid1);
+  if (fSplitFrame && cad_mesh) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<G4TessellatedSolid*> bodies = MeshBodies::Split(cad_mesh, "cad_solid");
+    cad_solids.assign(bodies.begin(), bodies.end());
+    G4cout << "----> Frame split into " << cad_solids.size() << " bodies in "
+      << 1.e3 * std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " ms" << G4endl;
+  }
 
   G4VisAttributes* detVisAtt = new G4VisAttributes(G4Colour(0.9, 0.9, 0.9));
   detVisAtt->SetForceWireframe(true);
   detVisAtt->SetForceSolid(true);
-  cad_logical->SetVisAttributes(detVisAtt);
 
   G4RotationMatrix rot = G4RotationMatrix();
   rot.rotateY(90 * deg);
   G4ThreeVector loc = G4ThreeVector(0 * cm, 306.5 * cm, -23 * cm);
   G4Transform3D transform(rot, loc);
-  new G4PVPlacement(
-    transform, cad_logical, "cadGeom", fWorldLogical, true, 0, checkOverlaps
-  );
+  for (std::size_t i = 0; i < cad_solids.size(); i++) {
+    G4LogicalVolume* cad_logical = new G4LogicalVolume(cad_solids[i], fAluminiumMaterial, "cad_logical");
+    cad_logical->SetVisAttributes(detVisAtt);
+    new G4PVPlacement(
+      transform, cad_logical, "cadGeom", fWorldLogical, true, i, checkOverlaps
+    );
+  }
 }
 
 void DetectorConstruction::ConstructScintillators()
@@ -365,6 +425,16 @@ void DetectorConstruction::ConstructScintillators()
   G4VisAttributes* boxVisAttWrapping = new G4VisAttributes(G4Colour(0.447059, 0.623529, 0.811765));
   boxVisAttWrapping->SetForceWireframe(true);
   boxVisAttWrapping->SetForceSolid(true);
+  G4LogicalVolume* stripLog = nullptr;
+  if (fLoadWrapping && fNestedWrapping) {
+    stripLog = ConstructWrappedStrip(boxVisAttWrapping);
+  }
+
+  //! Shell of the layer for the acceptance filter encloses the wrapped strips of any orientation
+  const G4double halfDiagonal = std::hypot(
+    DetectorConstants::scinDim[0] / 2.0 + DetectorConstants::wrappingThickness,
+    DetectorConstants::scinDim[1] / 2.0 + DetectorConstants::wrappingThickness
+  );
 
   G4int icopy = 1;
   G4int oldLayerNumber = fLayerNumber;
@@ -373,6 +443,14 @@ void DetectorConstruction::ConstructScintillators()
     fLayerNumber = oldLayerNumber + j + 1;
     Layer layTemp(fLayerNumber, "Layer nr " + std::to_string(fLayerNumber), DetectorConstants::radius[j]/10 /*to cm*/, 1);
     fLayerContainer.push_back(layTemp);
+    fAcceptanceFilter.AddLayer(
+      DetectorConstants::radius[j] - halfDiagonal, DetectorConstants::radius[j] + halfDiagonal,
+      DetectorConstants::scinDim[2] / 2.0
+    );
+    G4LogicalVolume* layerLog = ConstructLayerEnvelope(
+      DetectorConstants::radius[j] - halfDiagonal, DetectorConstants::radius[j] + halfDiagonal,
+      DetectorConstants::scinDim[2] / 2.0
+    );
     for (int i = 0; i < DetectorConstants::nSegments[j]; i++) {
       moduleNumber++;
       G4double phi = i * 2 * M_PI / DetectorConstants::nSegments[j];
@@ -395,18 +473,25 @@ void DetectorConstruction::ConstructScintillators()
       if (fCreateGeometryFile) {
         Scin scinTemp(
           moduleNumber, moduleNumber, DetectorConstants::scinDim[0], DetectorConstants::scinDim[1], DetectorConstants::scinDim[2],
-          DetectorConstants::radius[j]*cos((phi+fi)*180/M_PI)/10, DetectorConstants::radius[j]*sin((phi+fi)*180/M_PI)/10, 0
+          DetectorConstants::radius[j]*cos(phi+fi)/10, DetectorConstants::radius[j]*sin(phi+fi)/10, 0
         );
         fScinContainer.push_back(scinTemp);
         Slot slotTemp(moduleNumber, fLayerNumber, (phi+fi)*180/M_PI, "single");
         fSlotContainer.push_back(slotTemp);
       }
 
-      new G4PVPlacement(
-        transform, fScinLog, name, fWorldLogical, true, icopy, checkOverlaps
-      );
+      if (stripLog) {
+        new G4PVPlacement(
+          transform, stripLog, "strip_" + G4UIcommand::ConvertToString(icopy),
+          layerLog, true, icopy, checkOverlaps
+        );
+      } else {
+        new G4PVPlacement(
+          transform, fScinLog, name, layerLog, true, icopy, checkOverlaps
+        );
+      }
 
-      if (fLoadWrapping) {
+      if (fLoadWrapping && !stripLog) {
         G4VSolid* unionSolid = new G4SubtractionSolid(
           "wrapping", wrappingBox, scinBoxFree
         );
@@ -414,7 +499,7 @@ void DetectorConstruction::ConstructScintillators()
         wrappingLog->SetVisAttributes(boxVisAttWrapping);
         G4String nameWrapping = "wrapping_" + G4UIcommand::ConvertToString(icopy);
         new G4PVPlacement(
-          transform, wrappingLog, nameWrapping, fWorldLogical, true, icopy, checkOverlaps
+          transform, wrappingLog, nameWrapping, layerLog, true, icopy, checkOverlaps
         );
       }
       icopy++;
@@ -422,6 +507,247 @@ void DetectorConstruction::ConstructScintillators()
   }
 }
 
+/**
+ * Wrapping is the wrapping box with the scintillator box enlarged by the shift subtracted;
+ * the same region is covered here by two slabs along x and two along y, so no boolean solid
+ * is navigated. Kapton is 1 cm shorter than the scintillator at each end, as before.
+ */
+G4LogicalVolume* DetectorConstruction::ConstructWrappedStrip(G4VisAttributes* wrappingVisAtt)
+{
+  const G4double halfX = DetectorConstants::scinDim[0] / 2.0;
+  const G4double halfY = DetectorConstants::scinDim[1] / 2.0;
+  const G4double halfZ = DetectorConstants::scinDim[2] / 2.0;
+  const G4double thickness = DetectorConstants::wrappingThickness;
+  const G4double shift = DetectorConstants::wrappingShift;
+
+  G4Box* stripBox = new G4Box("stripBox", halfX + thickness, halfY + thickness, halfZ);
+  G4LogicalVolume* stripLog = new G4LogicalVolume(stripBox, fAir, "stripLogical");
+  stripLog->SetVisAttributes(G4VisAttributes::GetInvisible());
+
+  fScinInStrip = new G4PVPlacement(
+    0, G4ThreeVector(), fScinLog, "scin", stripLog, false, 0, checkOverlaps
+  );
+
+  G4Box* slabXBox = new G4Box("wrappingSlabX", halfX + thickness, (thickness - shift) / 2.0, halfZ - 1 * cm);
+  G4LogicalVolume* slabXLog = new G4LogicalVolume(slabXBox, fKapton, "wrappingSlabXLogical");
+  slabXLog->SetVisAttributes(wrappingVisAtt);
+  G4Box* slabYBox = new G4Box("wrappingSlabY", (thickness - shift) / 2.0, halfY + shift, halfZ - 1 * cm);
+  G4LogicalVolume* slabYLog = new G4LogicalVolume(slabYBox, fKapton, "wrappingSlabYLogical");
+  slabYLog->SetVisAttributes(wrappingVisAtt);
+
+  const G4double slabCenterY = halfY + (thickness + shift) / 2.0;
+  const G4double slabCenterX = halfX + (thickness + shift) / 2.0;
+  new G4PVPlacement(0, G4ThreeVector(0, slabCenterY, 0), slabXLog, "wrapping", stripLog, false, 0, checkOverlaps);
+  new G4PVPlacement(0, G4ThreeVector(0, -slabCenterY, 0), slabXLog, "wrapping", stripLog, false, 1, checkOverlaps);
+  new G4PVPlacement(0, G4ThreeVector(slabCenterX, 0, 0), slabYLog, "wrapping", stripLog, false, 2, checkOverlaps);
+  new G4PVPlacement(0, G4ThreeVector(-slabCenterX, 0, 0), slabYLog, "wrapping", stripLog, false, 3, checkOverlaps);
+  return stripLog;
+}
+
+/**
+ * Envelope encloses the strips of any orientation (the same shell as in the acceptance filter),
+ * so the world navigates a few tubes and the strips are looked up only inside the layer;
+ * placements in the envelope keep their copy numbers
+ */
+G4LogicalVolume* DetectorConstruction::ConstructLayerEnvelope(
+  G4double rMin, G4double rMax, G4double halfLength
+) {
+  if (!fLayerEnvelopes) return fWorldLogical;
+  G4String name = "layerEnvelope_" + G4UIcommand::ConvertToString(fLayerNumber);
+  G4Tubs* envelopeTubs = new G4Tubs(name, rMin, rMax, halfLength, 0.0, 2 * M_PI);
+  G4LogicalVolume* envelopeLog = new G4LogicalVolume(envelopeTubs, fAir, name + "Logical");
+  envelopeLog->SetVisAttributes(G4VisAttributes::GetInvisible());
+  new G4PVPlacement(
+    0, G4ThreeVector(), envelopeLog, name, fWorldLogical, false, fLayerNumber, checkOverlaps
+  );
+  return envelopeLog;
+}
+
+/**
+ * Scintillators are placed at their centers and rotated by the angle of their slot, with the ID
+ * as the copy number. Wrapped layers get the kapton as a subtraction solid next to each copy -
+ * the shared strip volume holds only the scintillator of the standard dimensions.
+ */
+void DetectorConstruction::ConstructScintillatorsFromDescription()
+{
+  fDescriptionScinLogs.clear();
+  G4VisAttributes* scinVisAtt = new G4VisAttributes(G4Colour(0.447059, 0.623529, 0.811765));
+  scinVisAtt->SetForceWireframe(true);
+  scinVisAtt->SetForceSolid(true);
+
+  //! Scintillators of the same dimensions share the logical volumes of the scintillator and of the wrapping
+  std::map<std::tuple<float, float, float>, std::pair<G4LogicalVolume*, G4LogicalVolume*>> logicals;
+  for (const Layer& layer : fDescription.fLayers) {
+    G4bool wrapped = fLoadWrapping && fDescription.IsWrapped(layer);
+    G4double thickness = wrapped ? DetectorConstants::wrappingThickness : 0.0;
+    std::vector<const Scin*> scins;
+    G4double rMin = kInfinity;
+    G4double rMax = 0.0;
+    G4double halfLength = 0.0;
+    for (const Scin& scin : fDescription.fScins) {
+      if (fDescription.GetLayerOf(scin).fID != layer.fID) continue;
+      scins.push_back(&scin);
+      G4double center = std::hypot(scin.fX_center, scin.fY_center) * cm;
+      G4double halfDiagonal = std::hypot(scin.fHeight / 2.0 + thickness, scin.fWidth / 2.0 + thickness);
+      rMin = std::min(rMin, center - halfDiagonal);
+      rMax = std::max(rMax, center + halfDiagonal);
+      halfLength = std::max(halfLength, std::abs(scin.fZ_center) * cm + scin.fLength / 2.0);
+    }
+    if (scins.empty()) continue;
+
+    fLayerNumber++;
+    rMin = std::max(rMin, 0.0);
+    fAcceptanceFilter.AddLayer(rMin, rMax, halfLength);
+    G4LogicalVolume* layerLog = ConstructLayerEnvelope(rMin, rMax, halfLength);
+    if (fCreateGeometryFile) {
+      fLayerContainer.push_back(layer);
+    }
+
+    for (const Scin* scin : scins) {
+      if (scin->fID < 1 || scin->fID > maxScinID) {
+        G4Exception(
+          "DetectorConstruction", "DC04", FatalException,
+          ("ID of the scintillator " + std::to_string(scin->fID) + " outside 1-"
+          + std::to_string(maxScinID) + " in " + fDescription.GetFileName()).c_str()
+        );
+        continue;
+      }
+      auto& logs = logicals[std::make_tuple(scin->fHeight, scin->fWidth, scin->fLength)];
+      if (!logs.first) {
+        G4Box* scinBox = new G4Box("scinBox", scin->fHeight / 2.0, scin->fWidth / 2.0, scin->fLength / 2.0);
+        logs.first = new G4LogicalVolume(scinBox, fScinMaterial, "scinLogical");
+        logs.first->SetVisAttributes(scinVisAtt);
+        fDescriptionScinLogs.push_back(logs.first);
+      }
+      if (wrapped && !logs.second) {
+        G4Box* scinBoxFree = new G4Box(
+          "scinBoxFree", scin->fHeight / 2.0 + DetectorConstants::wrappingShift,
+          scin->fWidth / 2.0 + DetectorConstants::wrappingShift, scin->fLength / 2.0
+        );
+        G4Box* wrappingBox = new G4Box(
+          "wrappingBox", scin->fHeight / 2.0 + thickness, scin->fWidth / 2.0 + thickness, scin->fLength / 2.0 - 1 * cm
+        );
+        G4VSolid* wrappingSolid = new G4SubtractionSolid("wrapping", wrappingBox, scinBoxFree);
+        logs.second = new G4LogicalVolume(wrappingSolid, fKapton, "wrappingLogical");
+        logs.second->SetVisAttributes(scinVisAtt);
+      }
+
+      const Slot& slot = fDescription.GetSlotOf(*scin);
+      G4RotationMatrix rot = G4RotationMatrix();
+      rot.rotateZ(slot.fTheta * deg);
+      G4ThreeVector loc = G4ThreeVector(scin->fX_center, scin->fY_center, scin->fZ_center) * cm;
+      G4Transform3D transform(rot, loc);
+      G4String id = G4UIcommand::ConvertToString(scin->fID);
+      new G4PVPlacement(transform, logs.first, "scin_" + id, layerLog, true, scin->fID, checkOverlaps);
+      if (wrapped) {
+        new G4PVPlacement(transform, logs.second, "wrapping_" + id, layerLog, true, scin->fID, checkOverlaps);
+      }
+
+      if (fCreateGeometryFile) {
+        fSlotContainer.push_back(slot);
+        fScinContainer.push_back(*scin);
+      }
+    }
+  }
+}
+
+/**
+ * Solids with a material are placed in their mother, solids without it are only components
+ * of the boolean solids. Like the hard-coded targets, solids placed in the world are shifted
+ * by the chamber center.
+ */
+void DetectorConstruction::ConstructSolidsFromDescription()
+{
+  std::map<std::string, G4VSolid*> solids;
+  std::map<std::string, G4LogicalVolume*> mothers = {{"world", fWorldLogical}};
+  //! Names resolved through the members - the material table also keeps the first, replaced vacuum
+  std::map<std::string, MaterialExtension*> materials;
+  for (MaterialExtension* material : {
+    fAir, fKapton, fVacuum, fPlexiglass, fXADMaterial, fScinMaterial, fAluminiumMaterial,
+    fSmallChamberMaterial, fSmallChamberRun7Material, fPolycarbonate, fPolyoxymethylene,
+    fSiliconDioxide, fStainlessSteel
+  }) {
+    materials[material->GetName()] = material;
+  }
+  for (const SolidDescription& solid : fDescription.fSolids) {
+    const std::string name = solid.GetString("name");
+    const std::string type = solid.GetString("type");
+    const G4double startPhi = solid.GetNumber("startPhi", 0.0) * deg;
+    const G4double deltaPhi = solid.GetNumber("deltaPhi", 360.0) * deg;
+
+    G4VSolid* g4Solid = nullptr;
+    if (type == "box") {
+      g4Solid = new G4Box(
+        name, solid.GetNumber("halfX", 0.0) * mm, solid.GetNumber("halfY", 0.0) * mm,
+        solid.GetNumber("halfZ", 0.0) * mm
+      );
+    } else if (type == "tubs") {
+      g4Solid = new G4Tubs(
+        name, solid.GetNumber("rMin", 0.0) * mm, solid.GetNumber("rMax", 0.0) * mm,
+        solid.GetNumber("halfZ", 0.0) * mm, startPhi, deltaPhi
+      );
+    } else if (type == "sphere") {
+      g4Solid = new G4Sphere(
+        name, solid.GetNumber("rMin", 0.0) * mm, solid.GetNumber("rMax", 0.0) * mm, startPhi, deltaPhi,
+        solid.GetNumber("startTheta", 0.0) * deg, solid.GetNumber("deltaTheta", 180.0) * deg
+      );
+    } else if (type == "polycone") {
+      std::vector<G4double> z = solid.GetArray("z");
+      std::vector<G4double> rInner = solid.GetArray("rMin");
+      std::vector<G4double> rOuter = solid.GetArray("rMax");
+      for (std::size_t i = 0; i < z.size(); i++) {
+        z[i] *= mm;
+        rInner[i] *= mm;
+        rOuter[i] *= mm;
+      }
+      g4Solid = new G4Polycone(name, startPhi, deltaPhi, z.size(), z.data(), rInner.data(), rOuter.data());
+    } else if (type == "stl") {
+      g4Solid = fMeshCache.Load(solid.GetString("file"), solid.GetNumber("scale", 1.0) * mm, name);
+    } else {
+      G4VSolid* first = solids[solid.GetString("first")];
+      G4VSolid* second = solids[solid.GetString("second")];
+      G4Transform3D transform = solid.GetTransform("secondPosition", "secondRotation");
+      if (type == "union") {
+        g4Solid = new G4UnionSolid(name, first, second, transform);
+      } else if (type == "subtraction") {
+        g4Solid = new G4SubtractionSolid(name, first, second, transform);
+      } else {
+        g4Solid = new G4IntersectionSolid(name, first, second, transform);
+      }
+    }
+    solids[name] = g4Solid;
+    if (!solid.Has("material") || !g4Solid) continue;
+
+    auto material = materials.find(solid.GetString("material"));
+    if (material == materials.end()) {
+      G4Exception(
+        "DetectorConstruction", "DC05", FatalException,
+        ("Material " + solid.GetString("material") + " of the solid " + name + " in "
+        + fDescription.GetFileName() + " is not defined in the simulation").c_str()
+      );
+      continue;
+    }
+    G4LogicalVolume* logical = new G4LogicalVolume(g4Solid, material->second, name + "_logical");
+    std::vector<G4double> colour = solid.GetArray("colour", {0.9, 0.9, 0.9});
+    G4VisAttributes* visAtt = new G4VisAttributes(
+      G4Colour(colour[0], colour[1], colour[2], colour.size() > 3 ? colour[3] : 1.0)
+    );
+    visAtt->SetForceWireframe(true);
+    visAtt->SetForceSolid(true);
+    logical->SetVisAttributes(visAtt);
+
+    const std::string mother = solid.GetString("mother", "world");
+    G4Transform3D transform = solid.GetTransform("position", "rotation");
+    if (mother == "world") {
+      transform = G4Translate3D(DetectorConstants::GetChamberCenter()) * transform;
+    }
+    new G4PVPlacement(
+      transform, logical, name, mothers[mother], true, static_cast<G4int>(solid.GetNumber("copy", 0)), checkOverlaps
+    );
+    mothers[name] = logical;
+  }
+}
+
 /**
  * Construction of modular layer (4th) - added by S. Sharma 20.06.2018
  */
@@ -519,6 +845,13 @@ void DetectorConstruction::ConstructLayers(std::vector<G4double>& radius_dynamic
 
   Layer layTemp(fLayerNumber, "Layer nr " + std::to_string(fLayerNumber), radius_dynamic[6], 1);
   fLayerContainer.push_back(layTemp);
+  const G4double halfDiagonal = std::hypot(
+    DetectorConstants::scinDim_inModule[0] / 2.0, DetectorConstants::scinDim_inModule[1] / 2.0
+  );
+  const G4double rMin = *std::min_element(radius_dynamic.begin(), radius_dynamic.end()) * cm - halfDiagonal;
+  const G4double rMax = *std::max_element(radius_dynamic.begin(), radius_dynamic.end()) * cm + halfDiagonal;
+  fAcceptanceFilter.AddLayer(rMin, rMax, DetectorConstants::scinDim_inModule[2] / 2.0);
+  G4LogicalVolume* layerLog = ConstructLayerEnvelope(rMin, rMax, DetectorConstants::scinDim_inModule[2] / 2.0);
 
   G4int moduleNumber = 0;
   for (int i = 0; i < numberofModules; i++){
@@ -544,7 +877,7 @@ void DetectorConstruction::ConstructLayers(std::vector<G4double>& radius_dynamic
       }
 
       new G4PVPlacement(
-        transform, fScinLogInModule, nameNewI, fWorldLogical,
+        transform, fScinLogInModule, nameNewI, layerLog,
         true, icopyI + i * 13 + j + 6, checkOverlaps
       );
     }
@@ -1239,9 +1572,7 @@ void DetectorConstruction::ConstructTargetRun12()
     fWorldLogical, true, 0, checkOverlaps);
   
   // Ring between Spherical Chamber and outer cylinder
-  CADMesh* mesh2 = new CADMesh((char*)"stl_geometry/Ring_SphericalChamber.stl");
-  mesh2->SetScale(cm);
-  G4VSolid* cadRing = mesh2->TessellatedMesh();
+  G4VSolid* cadRing = fMeshCache.Load("stl_geometry/Ring_SphericalChamber.stl", cm, "cadRing");
   G4LogicalVolume* cadRing_logical = new G4LogicalVolume( 
     cadRing,fPolyoxymethylene , "cadRing_logical");
 
@@ -16,8 +16,11 @@
 #ifndef DETECTORCONSTRUCTION_H
 #define DETECTORCONSTRUCTION_H 1
 
+#include "GeometryDescription.h"
 #include "MaterialExtension.h"
+#include "AcceptanceFilter.h"
 #include "DetectorSD.h"
+#include "MeshCache.h"
 
 #include <G4VUserDetectorConstruction.hh>
 #include <G4GeometryManager.hh>
@@ -32,16 +35,12 @@
 #include <G4Material.hh>
 #include <G4Element.hh>
 #include <G4Colour.hh>
-#include <CADMesh.hh>
 #include <G4Cache.hh>
 #include <globals.hh>
 #include <G4Box.hh>
 #include <vector>
 
 class DetectorConstructionMessenger;
-struct Layer;
-struct Scin;
-struct Slot;
 
 //! Flag for debugging purposes
 const G4bool checkOverlaps = false;
@@ -73,6 +72,15 @@ public:
   //! Basic geometry with 3 layers of scintillators
   void ConstructBasicGeometry(G4bool tf) { fLoadScintillators = tf; };
   void LoadFrame(G4bool tf) { fLoadCADFrame = tf; };
+  //! Scintillator and kapton slabs in a shared strip volume (default) or per copy subtraction solids
+  void SetNestedWrapping(G4bool tf) { fNestedWrapping = tf; };
+  //! Each layer of scintillators placed in its own G4Tubs envelope instead of directly in the world
+  void SetLayerEnvelopes(G4bool tf) { fLayerEnvelopes = tf; };
+  //! Facets of the CAD files read from the cache instead of parsing the STL files (default true)
+  void SetMeshCache(G4bool tf) { fMeshCache.SetEnabled(tf); };
+  void SetMeshCacheDirectory(const G4String& directory) { fMeshCache.SetDirectory(directory); };
+  //! CAD frame as a single tessellated solid (default) or split into its separate bodies
+  void SetSplitFrame(G4bool tf) { fSplitFrame = tf; };
 
   //! Modular layer (known as 4th layer); 24 modules filled with scintillators
   void ConstructModularLayer(const G4String& module_name) {
@@ -87,6 +95,9 @@ public:
     }
   }
 
+  //! Layers, scintillators and targets built from the description file instead of the code; "none" switches it off
+  void LoadGeometryFile(const G4String& fileName);
+
   //! Writing out detector setup in json format
   void CreateGeometryFileFlag(G4bool tf) { fCreateGeometryFile = tf; };
   void SetGeometryFileName(G4String fileName) { fGeometryFileName = fileName; };
@@ -94,6 +105,10 @@ public:
   void CreateGeometryFile();
 
   G4int GetRunNumber() const { return fRunNumber; };
+  //! Layers of scintillators of the constructed geometry, shared by all threads
+  const AcceptanceFilter& GetAcceptanceFilter() const { return fAcceptanceFilter; };
+  //! Incremented with every construction, caches depending on the geometry compare it
+  G4int GetGeometryVersion() const { return fGeometryVersion; };
 
 private:
   static G4ThreadLocal G4bool fConstructedSDandField;
@@ -102,7 +117,8 @@ private:
   DetectorConstruction();
   virtual ~DetectorConstruction();
   DetectorConstructionMessenger* fMessenger = nullptr;
-  HistoManager* fHistoManager;
+  //! Each worker thread has its own HistoManager
+  G4Cache<HistoManager*> fHistoManager;
 
   //! Load materials from NIST database
   void InitializeMaterials();
@@ -110,6 +126,10 @@ private:
   void ConstructFrameCAD();
   //! Create scintillators only; dimensions are right now fixed in code
   void ConstructScintillators();
+  //! Air box of the wrapped scintillator holding the scintillator and the wrapping, shared by all strips
+  G4LogicalVolume* ConstructWrappedStrip(G4VisAttributes* wrappingVisAtt);
+  //! Mother volume of the layer: air G4Tubs placed in the world, or the world without envelopes
+  G4LogicalVolume* ConstructLayerEnvelope(G4double rMin, G4double rMax, G4double halfLength);
   //! Construct modular layer inserted into detector (refered as 4th layer)
   void ConstructScintillatorsModularLayer();
   //! Create target used in run3 - big chamber no XAD material inside
@@ -123,6 +143,11 @@ private:
   //! Create target for run12
   void ConstructTargetRun12();
 
+  //! Scintillators of the description; each layer gets its own shell in the acceptance filter
+  void ConstructScintillatorsFromDescription();
+  //! Target solids of the description, placed in the order of the file
+  void ConstructSolidsFromDescription();
+
   void ConstructLayers(
     std::vector<G4double>& radius_dynamic, G4int& numberofModules,
     G4double& AngDisp_dynamic, G4int& icopyI);
@@ -135,12 +160,18 @@ private:
   G4bool fLoadCADFrame;
   //! Flag for loading wrapping tf the scintillators
   G4bool fLoadWrapping;
+  G4bool fNestedWrapping = true;
+  G4bool fLayerEnvelopes = false;
+  G4bool fSplitFrame = false;
   //! Flag for loading modular (4th) layer
   G4bool fLoadModularLayer;
   //! For creating file with geometry, by default not created, if yes, in big barrel format
   G4bool fCreateGeometryFile = false;
   G4String fGeometryFileName = "mc_geant_setup.json";
   G4String fGeometryFileType = "barrel";
+  //! Flag for building the geometry from the description file
+  G4bool fLoadDescription = false;
+  GeometryDescription fDescription;
 
   G4Box* fWorldSolid = nullptr;
   G4LogicalVolume* fWorldLogical = nullptr;
@@ -165,6 +196,10 @@ private:
 
   G4LogicalVolume* fScinLog = nullptr;
   G4LogicalVolume* fScinLogInModule = nullptr;
+  //! Placement of the scintillator in the shared strip, its ID is the copy number of the strip
+  G4VPhysicalVolume* fScinInStrip = nullptr;
+  //! Sensitive volumes of the description, one per dimensions of the scintillators
+  std::vector<G4LogicalVolume*> fDescriptionScinLogs;
   G4Cache<DetectorSD*> fDetectorSD;
   //! Geometry Kind for the modular layer
   GeometryKind fGeoKind = GeometryKind::Unknown;
@@ -173,51 +208,15 @@ private:
   //! Pressure in chamber
   G4double fPressure = 1.e-19 *pascal;
 
+  AcceptanceFilter fAcceptanceFilter;
+  MeshCache fMeshCache;
+  G4int fGeometryVersion = 0;
+
   std::vector<Layer> fLayerContainer;
   std::vector<Scin> fScinContainer;
   std::vector<Slot> fSlotContainer;
   G4int fLayerNumber = 0;
 };
 
-struct Frame {
-  int fID;
-  int fCreatorID;
-  int fVersion;
-  std::string fStatus;
-  std::string fDescription;
-  bool fActive;
-};
-
-struct Layer {
-  int fID;
-  std::string fName;
-  double fRadius;
-  int fSetupID;
-  Layer(int id, const std::string& name, double radius, int setupID) :
-    fID(id), fName(name), fRadius(radius), fSetupID(setupID) {}
-};
-
-struct Slot {
-  int fID;
-  int fLayerID;
-  double fTheta;
-  std::string fType;
-  Slot(int id, int layerID, double theta, const std::string& type) :
-    fID(id), fLayerID(layerID), fTheta(theta), fType(type) {}
-};
-
-struct Scin {
-  int fID;
-  int fSlotID;
-  float fHeight;
-  float fWidth;
-  float fLength;
-  double fX_center;
-  double fY_center;
-  double fZ_center;
-  Scin(int id, int slotID, double height, double width, double length, double x_center, double y_center, double z_center) :
-    fID(id), fSlotID(slotID), fHeight(height), fWidth(width), fLength(length), fX_center(x_center), fY_center(y_center), fZ_center(z_center) {}
-};
-
 void replace(std::string& json, const std::string& placeholder);
 #endif /* !DETECTORCONSTRUCTION_H */
@@ -33,7 +33,7 @@ DetectorSD::~DetectorSD() {}
 
 void DetectorSD::Initialize(G4HCofThisEvent* HCE)
 {
-  static int HCID = -1;
+  static G4ThreadLocal int HCID = -1;
   fDetectorCollection = new DetectorHitsCollection(SensitiveDetectorName, collectionName[0]);
 
   if (HCID < 0) {
@@ -76,7 +76,7 @@ G4bool DetectorSD::ProcessHits(G4Step* aStep, G4TouchableHistory*)
 
   G4TouchableHistory* theTouchable = (G4TouchableHistory*) (aStep->GetPreStepPoint()->GetTouchable());
   G4VPhysicalVolume* physVol = theTouchable->GetVolume();
-  G4int currentScinCopy = physVol->GetCopyNo();
+  G4int currentScinCopy = physVol == fScinInStrip ? theTouchable->GetCopyNumber(1) : physVol->GetCopyNo();
   G4double currentTime = aStep->GetPreStepPoint()->GetGlobalTime();
   if ((fPreviousHits[currentScinCopy].fID != -1) && (abs(fPreviousHits[currentScinCopy].fTime - currentTime) < fTimeIntervals)) {
     //! update track
@@ -84,21 +84,27 @@ G4bool DetectorSD::ProcessHits(G4Step* aStep, G4TouchableHistory*)
     (*fDetectorCollection)[fPreviousHits[currentScinCopy].fID]->AddInteraction();
     (*fDetectorCollection)[fPreviousHits[currentScinCopy].fID]->AddTime(currentTime, edep);
     (*fDetectorCollection)[fPreviousHits[currentScinCopy].fID]->AddPosition(aStep->GetPostStepPoint()->GetPosition(), edep);
+    fMetrics->Add(fMergedHits);
   } else {
     //! new hit - interaction types compton, msc (multiple compton scatterings)
     DetectorHit* newHit = new DetectorHit();
     newHit->SetEdep(edep);
     newHit->SetTrackID(aStep->GetTrack()->GetTrackID());
     newHit->SetTrackPDG(aStep->GetTrack()->GetParticleDefinition()->GetPDGEncoding());
-    newHit->SetProcessName(aStep->GetPostStepPoint()->GetProcessDefinedStep()->GetProcessName());
+    newHit->SetProcess(aStep->GetPostStepPoint()->GetProcessDefinedStep());
     newHit->SetInteractionNumber();
     newHit->SetPosition(aStep->GetPostStepPoint()->GetPosition(), edep);
     newHit->SetTime(currentTime, edep);
-    newHit->SetScinID(physVol->GetCopyNo());
-    newHit->SetPolarizationIn(aStep->GetPreStepPoint()->GetPolarization());
-    newHit->SetMomentumIn(aStep->GetPreStepPoint()->GetMomentum());
-    newHit->SetPolarizationOut(aStep->GetPostStepPoint()->GetPolarization());
-    newHit->SetMomentumOut(aStep->GetPostStepPoint()->GetMomentum());
+    newHit->SetScinID(currentScinCopy);
+    //! Switched off groups are not written, HistoManager stores zeros for them
+    if (fEvtMessenger->StorePolarization()) {
+      newHit->SetPolarizationIn(aStep->GetPreStepPoint()->GetPolarization());
+      newHit->SetPolarizationOut(aStep->GetPostStepPoint()->GetPolarization());
+    }
+    if (fEvtMessenger->StoreMomentum()) {
+      newHit->SetMomentumIn(aStep->GetPreStepPoint()->GetMomentum());
+      newHit->SetMomentumOut(aStep->GetPostStepPoint()->GetMomentum());
+    }
 
     //! only particles generated by user has PrimaryParticleInformation
     if (aStep->GetTrack()->GetParentID() == 0) {
@@ -108,6 +114,9 @@ G4bool DetectorSD::ProcessHits(G4Step* aStep, G4TouchableHistory*)
       if (info != 0) {
         newHit->SetGenGammaMultiplicity(info->GetGammaMultiplicity());
         newHit->SetGenGammaIndex(info->GetIndex());
+        if (info->GetGammaMultiplicity() == info->GetGeneratedGammaMultiplicity()) {
+          info->SetRegistered(true);
+        }
         //! should be marked as scattering
         info->SetGammaMultiplicity(info->GetGammaMultiplicity() + PrimaryParticleInformation::kScatteringInActivePartAddition);
         if (fHistoManager) {
@@ -129,6 +138,7 @@ G4bool DetectorSD::ProcessHits(G4Step* aStep, G4TouchableHistory*)
       newHit->SetGenGammaMultiplicity(fHistoManager->GetParentIDofPhoton() * PrimaryParticleInformation::kSecondaryParticleMultiplication);
     }
     G4int id = fDetectorCollection->insert(newHit);
+    fMetrics->Add(fCreatedHits);
     fPreviousHits[currentScinCopy].fID = id - 1;
     fPreviousHits[currentScinCopy].fTime = currentTime;
   }
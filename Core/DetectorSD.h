@@ -18,6 +18,7 @@
 
 #include "../Objects/Geant4/DetectorHit.h"
 #include "HistoManager.h"
+#include "RunMetrics.h"
 
 #include <G4VSensitiveDetector.hh>
 #include "../Info/EventMessenger.h"
@@ -30,6 +31,8 @@ public:
   virtual void Initialize(G4HCofThisEvent* HCE);
   
   void SetHistoManager(HistoManager* histo) {fHistoManager = histo;}
+  //! Scintillator placed in the shared strip volume takes its ID from the strip placement
+  void SetScintillatorInStrip(const G4VPhysicalVolume* scin) { fScinInStrip = scin; }
 
 private:
   struct HitParameters {
@@ -39,12 +42,17 @@ private:
   };
   
   HistoManager* fHistoManager = nullptr;
+  const G4VPhysicalVolume* fScinInStrip = nullptr;
 
   G4double fTimeIntervals;
   G4int fToTScinNum;
   std::vector<HitParameters> fPreviousHits;
   DetectorHitsCollection* fDetectorCollection = nullptr;
   EventMessenger* fEvtMessenger = EventMessenger::GetEventMessenger();
+  //! Sensitive detector is created by the thread which uses it
+  RunMetrics* fMetrics = RunMetrics::GetInstance();
+  MetricHandle fCreatedHits = fMetrics->Counter("hits.created");
+  MetricHandle fMergedHits = fMetrics->Counter("hits.merged");
 
 protected:
   virtual G4bool ProcessHits(G4Step* aStep, G4TouchableHistory* ROhist);
@@ -0,0 +1,99 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file EventPackWriter.cpp
+ */
+
+#include "EventPackWriter.h"
+
+#include <chrono>
+
+EventPackWriter::EventPackWriter(std::function<void(JPetGeantEventPack*)> sink, G4int ringSize) :
+fSink(sink)
+{
+  //! one pack is filled by the tracking thread while the other one is written
+  if (ringSize < 2) {
+    ringSize = 2;
+  }
+  for (G4int i = 0; i < ringSize; i++) {
+    fRing.push_back(new JPetGeantEventPack());
+    fFreePacks.push_back(fRing.back());
+  }
+  fThread = std::thread(&EventPackWriter::Run, this);
+}
+
+EventPackWriter::~EventPackWriter()
+{
+  Stop();
+  for (JPetGeantEventPack* pack : fRing) {
+    delete pack;
+  }
+}
+
+JPetGeantEventPack* EventPackWriter::Acquire()
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  if (fFreePacks.empty()) {
+    fBackPressureCount++;
+    auto start = std::chrono::steady_clock::now();
+    fFreeCondition.wait(lock, [this] { return !fFreePacks.empty(); });
+    fBackPressureTime += std::chrono::duration<G4double>(std::chrono::steady_clock::now() - start).count();
+  }
+  JPetGeantEventPack* pack = fFreePacks.front();
+  fFreePacks.pop_front();
+  return pack;
+}
+
+void EventPackWriter::Submit(JPetGeantEventPack* pack)
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fFilledPacks.push_back(pack);
+  }
+  fFilledCondition.notify_one();
+}
+
+void EventPackWriter::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStopRequested = true;
+  }
+  fFilledCondition.notify_one();
+  if (fThread.joinable()) {
+    fThread.join();
+  }
+}
+
+void EventPackWriter::Run()
+{
+  while (true) {
+    JPetGeantEventPack* pack = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fFilledCondition.wait(lock, [this] { return fStopRequested || !fFilledPacks.empty(); });
+      if (fFilledPacks.empty()) {
+        //! stop requested and nothing left to write
+        return;
+      }
+      pack = fFilledPacks.front();
+      fFilledPacks.pop_front();
+    }
+    fSink(pack);
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fWrittenPacks++;
+      fFreePacks.push_back(pack);
+    }
+    fFreeCondition.notify_one();
+  }
+}
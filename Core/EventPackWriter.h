@@ -0,0 +1,72 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file EventPackWriter.h
+ */
+
+#ifndef EVENTPACKWRITER_H
+#define EVENTPACKWRITER_H 1
+
+#include "../Objects/Framework/JPetGeantEventPack.h"
+
+#include <condition_variable>
+#include <functional>
+#include <globals.hh>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <deque>
+
+/**
+ * @class EventPackWriter
+ * @brief writes event packs on a dedicated thread, so the tracking thread does not wait for
+ * basket compression and disk writes; packs are taken from a ring of preallocated objects
+ * and the queue of filled packs is bounded by the size of the ring
+ */
+class EventPackWriter
+{
+public:
+  //! Sink is called on the writer thread for each submitted pack (e.g. TTree::Fill)
+  EventPackWriter(std::function<void(JPetGeantEventPack*)> sink, G4int ringSize);
+  ~EventPackWriter();
+
+  //! Returns free pack for the next event; waits if all packs are queued for writing
+  JPetGeantEventPack* Acquire();
+  //! Hands filled pack to the writer thread
+  void Submit(JPetGeantEventPack* pack);
+  //! Writes all queued packs and stops the writer thread
+  void Stop();
+
+  //! Number of times the tracking thread had to wait for a free pack
+  G4long GetBackPressureCount() const { return fBackPressureCount; }
+  //! Time spent by the tracking thread waiting for a free pack [s]
+  G4double GetBackPressureTime() const { return fBackPressureTime; }
+  G4long GetWrittenPacks() const { return fWrittenPacks; }
+
+private:
+  void Run();
+
+  std::function<void(JPetGeantEventPack*)> fSink;
+  std::vector<JPetGeantEventPack*> fRing;
+  std::deque<JPetGeantEventPack*> fFreePacks;
+  std::deque<JPetGeantEventPack*> fFilledPacks;
+  std::mutex fMutex;
+  std::condition_variable fFreeCondition;
+  std::condition_variable fFilledCondition;
+  std::thread fThread;
+  bool fStopRequested = false;
+  G4long fBackPressureCount = 0;
+  G4double fBackPressureTime = 0.0;
+  G4long fWrittenPacks = 0;
+};
+
+#endif /* !EVENTPACKWRITER_H */
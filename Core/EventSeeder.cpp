@@ -0,0 +1,74 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file EventSeeder.cpp
+ */
+
+#include "EventSeeder.h"
+
+#include <G4RunManager.hh>
+#include <Randomize.hh>
+#include <unistd.h>
+#include <G4Run.hh>
+#include <random>
+#include <chrono>
+
+G4long EventSeeder::fRunSeed = 0;
+G4long EventSeeder::fEventOffset = 0;
+
+std::uint64_t EventSeeder::Mix(std::uint64_t value)
+{
+  value += 0x9E3779B97F4A7C15ULL;
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+  return value ^ (value >> 31);
+}
+
+void EventSeeder::SetRunSeed(G4long seed)
+{
+  if (seed != 0) {
+    fRunSeed = seed;
+    return;
+  }
+  /**
+   * Time alone is the same for jobs started in the same second on a cluster,
+   * so it is mixed with the process id and the entropy source of the system.
+   * Seed is kept positive, so it can be saved and given back with /jpetmc/SetSeed.
+   */
+  std::random_device entropy;
+  std::uint64_t state = Mix(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+  state = Mix(state ^ static_cast<std::uint64_t>(::getpid()));
+  state = Mix(state ^ ((static_cast<std::uint64_t>(entropy()) << 32) | entropy()));
+  fRunSeed = static_cast<G4long>(state >> 1);
+  if (fRunSeed == 0) fRunSeed = 1;
+}
+
+void EventSeeder::SeedEvent(G4int eventID, G4int attempt)
+{
+  const G4Run* run = G4RunManager::GetRunManager()->GetCurrentRun();
+  G4int runID = run ? run->GetRunID() : 0;
+  std::uint64_t state = Mix(static_cast<std::uint64_t>(fRunSeed));
+  state = Mix(state ^ static_cast<std::uint64_t>(runID));
+  state = Mix(state ^ static_cast<std::uint64_t>(GetGlobalEventID(eventID)));
+  state = Mix(state ^ static_cast<std::uint64_t>(attempt));
+  //! Both halves are used, zero ends the list of seeds
+  long seeds[3] = {
+    static_cast<long>(state & 0x7FFFFFFF) | 1, static_cast<long>((state >> 32) & 0x7FFFFFFF) | 1, 0
+  };
+  G4Random::setTheSeeds(seeds);
+}
+
+unsigned int EventSeeder::DrawROOTSeed()
+{
+  //! TRandom3 treats seed 0 as a request for a time based seed
+  return static_cast<unsigned int>(G4UniformRand() * 4294967295.0) | 1;
+}
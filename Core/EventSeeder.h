@@ -0,0 +1,51 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file EventSeeder.h
+ */
+
+#ifndef EVENTSEEDER_H
+#define EVENTSEEDER_H 1
+
+#include <globals.hh>
+#include <cstdint>
+
+/**
+ * @class EventSeeder
+ * @brief seeds the random engines separately for each event from (run seed, run, global event ID, attempt),
+ * so any event can be regenerated alone and the output does not depend on the number of threads or shards
+ */
+class EventSeeder
+{
+public:
+  //! Seed of the run; called on the master before the workers start, 0 - seed from time, pid and entropy
+  static void SetRunSeed(G4long seed);
+  static G4long GetRunSeed() { return fRunSeed; };
+  //! Events of shard i of a campaign start at i * events per job
+  static void SetEventOffset(G4long offset) { fEventOffset = offset; };
+  static G4long GetEventOffset() { return fEventOffset; };
+  //! Event ID unique in the whole campaign
+  static G4long GetGlobalEventID(G4int eventID) { return fEventOffset + eventID; };
+  //! Seeds G4Random; attempt counts repeated generation of the same event (killed events)
+  static void SeedEvent(G4int eventID, G4int attempt);
+  //! Seed for gRandom drawn from the stream of the current event
+  static unsigned int DrawROOTSeed();
+
+private:
+  //! SplitMix64 finalizer, every input bit affects all output bits
+  static std::uint64_t Mix(std::uint64_t value);
+
+  static G4long fRunSeed;
+  static G4long fEventOffset;
+};
+
+#endif /* !EVENTSEEDER_H */
@@ -0,0 +1,340 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file GeometryDescription.cpp
+ */
+
+#include "GeometryDescription.h"
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <G4SystemOfUnits.hh>
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <set>
+
+namespace pt = boost::property_tree;
+
+namespace
+{
+  const std::set<std::string> kSolidTypes = {
+    "box", "tubs", "sphere", "polycone", "stl", "union", "subtraction", "intersection"
+  };
+  const std::set<std::string> kStringFields = {"name", "type", "material", "mother", "file", "first", "second"};
+
+  void Fail(const G4String& fileName, const std::string& message)
+  {
+    G4String text = "Geometry description " + fileName + ": " + message;
+    G4Exception("GeometryDescription", "GD01", FatalException, text.c_str());
+  }
+
+  const pt::ptree& GetChildren(const pt::ptree& node, const std::string& key)
+  {
+    static const pt::ptree empty;
+    auto child = node.get_child_optional(key);
+    return child ? *child : empty;
+  }
+}
+
+std::string SolidDescription::GetString(const std::string& key, const std::string& value) const
+{
+  auto it = fStrings.find(key);
+  return it != fStrings.end() ? it->second : value;
+}
+
+double SolidDescription::GetNumber(const std::string& key, double value) const
+{
+  auto it = fNumbers.find(key);
+  return it != fNumbers.end() ? it->second : value;
+}
+
+std::vector<double> SolidDescription::GetArray(const std::string& key, const std::vector<double>& value) const
+{
+  auto it = fArrays.find(key);
+  return it != fArrays.end() ? it->second : value;
+}
+
+G4bool SolidDescription::Has(const std::string& key) const
+{
+  return fStrings.count(key) || fNumbers.count(key) || fArrays.count(key);
+}
+
+G4Transform3D SolidDescription::GetTransform(const std::string& positionKey, const std::string& rotationKey) const
+{
+  std::vector<double> position = GetArray(positionKey, {0.0, 0.0, 0.0});
+  std::vector<double> rotation = GetArray(rotationKey, {0.0, 0.0, 0.0});
+  G4RotationMatrix rot = G4RotationMatrix();
+  rot.rotateX(rotation[0] * deg);
+  rot.rotateY(rotation[1] * deg);
+  rot.rotateZ(rotation[2] * deg);
+  return G4Transform3D(rot, G4ThreeVector(position[0], position[1], position[2]) * mm);
+}
+
+/**
+ * Units are the ones of CreateGeometryFile: layer radius and centers of the scintillators in cm,
+ * angles of the slots in degrees, dimensions of the scintillators in mm. In the barrel format
+ * the centers are not stored, scintillators are placed on the layer radius at the slot angle.
+ * Layer with "slots" (number of slots) is a ring of equally spaced scintillators starting at
+ * "theta", with dimensions "scinHeight", "scinWidth", "scinLength"; IDs of its slots and
+ * scintillators start at "firstScinID" or follow the highest ID given explicitly.
+ */
+void GeometryDescription::Read(const G4String& fileName)
+{
+  fFileName = fileName;
+  fLayers.clear();
+  fSlots.clear();
+  fScins.clear();
+  fSolids.clear();
+  fWrappedLayers.clear();
+  fLayerIndex.clear();
+  fSlotIndex.clear();
+
+  pt::ptree root;
+  try {
+    pt::read_json(fileName, root);
+  } catch (const pt::json_parser_error& error) {
+    Fail(fileName, error.what());
+    return;
+  }
+
+  //! Files written by CreateGeometryFile keep the setup under a single run key
+  const pt::ptree* setup = &root;
+  const std::vector<std::string> keys = {"layer", "layers", "slot", "barrelSlots", "scin", "scintillators", "solids"};
+  G4bool hasKey = std::any_of(keys.begin(), keys.end(), [&root](const std::string& key) { return root.count(key) > 0; });
+  if (!hasKey && root.size() == 1) {
+    setup = &root.front().second;
+  }
+
+  struct Ring {
+    int fLayerID;
+    int fSlots;
+    double fTheta;
+    double fHeight;
+    double fWidth;
+    double fLength;
+    int fFirstID;
+  };
+  std::vector<Ring> rings;
+
+  try {
+    for (const std::string key : {"layer", "layers"}) {
+      for (const auto& item : GetChildren(*setup, key)) {
+        const pt::ptree& node = item.second;
+        int id = node.get<int>("id");
+        fLayers.emplace_back(
+          id, node.get<std::string>("name", "Layer nr " + std::to_string(id)), node.get<double>("radius"),
+          node.get<int>("setup_id", node.get<int>("frames_id", 1))
+        );
+        if (node.get<bool>("wrapping", false)) {
+          fWrappedLayers.push_back(id);
+        }
+        if (node.count("slots")) {
+          rings.push_back({
+            id, node.get<int>("slots"), node.get<double>("theta", 0.0), node.get<double>("scinHeight"),
+            node.get<double>("scinWidth"), node.get<double>("scinLength"), node.get<int>("firstScinID", 0)
+          });
+        }
+      }
+    }
+    for (const auto& item : GetChildren(*setup, "slot")) {
+      const pt::ptree& node = item.second;
+      fSlots.emplace_back(
+        node.get<int>("id"), node.get<int>("layer_id"), node.get<double>("theta"),
+        node.get<std::string>("type", "single")
+      );
+    }
+    for (const auto& item : GetChildren(*setup, "barrelSlots")) {
+      const pt::ptree& node = item.second;
+      fSlots.emplace_back(node.get<int>("id"), node.get<int>("layers_id"), node.get<double>("theta1"), "single");
+    }
+    for (const auto& item : GetChildren(*setup, "scin")) {
+      const pt::ptree& node = item.second;
+      fScins.emplace_back(
+        node.get<int>("id"), node.get<int>("slot_id"), node.get<double>("height"), node.get<double>("width"),
+        node.get<double>("length"), node.get<double>("xcenter"), node.get<double>("ycenter"),
+        node.get<double>("zcenter", 0.0)
+      );
+    }
+    for (const auto& item : GetChildren(*setup, "scintillators")) {
+      const pt::ptree& node = item.second;
+      //! Centers are filled once all slots and layers are known
+      fScins.emplace_back(
+        node.get<int>("id"), node.get<int>("barrelSlots_id"), node.get<double>("height"),
+        node.get<double>("width"), node.get<double>("length"), NAN, NAN, 0.0
+      );
+    }
+
+    for (const auto& item : GetChildren(*setup, "solids")) {
+      SolidDescription solid;
+      for (const auto& field : item.second) {
+        if (kStringFields.count(field.first)) {
+          solid.fStrings[field.first] = field.second.get_value<std::string>();
+        } else if (field.second.empty()) {
+          solid.fNumbers[field.first] = field.second.get_value<double>();
+        } else {
+          std::vector<double>& values = solid.fArrays[field.first];
+          for (const auto& value : field.second) {
+            values.push_back(value.second.get_value<double>());
+          }
+        }
+      }
+      fSolids.push_back(solid);
+    }
+  } catch (const pt::ptree_error& error) {
+    Fail(fileName, error.what());
+    return;
+  }
+
+  for (std::size_t i = 0; i < fLayers.size(); i++) {
+    if (!fLayerIndex.emplace(fLayers[i].fID, i).second) {
+      Fail(fileName, "layer " + std::to_string(fLayers[i].fID) + " defined twice");
+      return;
+    }
+  }
+
+  int nextID = 1;
+  for (const Slot& slot : fSlots) nextID = std::max(nextID, slot.fID + 1);
+  for (const Scin& scin : fScins) nextID = std::max(nextID, scin.fID + 1);
+  for (const Ring& ring : rings) {
+    int id = ring.fFirstID > 0 ? ring.fFirstID : nextID;
+    double radius = fLayers[fLayerIndex[ring.fLayerID]].fRadius;
+    for (int i = 0; i < ring.fSlots; i++) {
+      double theta = ring.fTheta + i * 360.0 / ring.fSlots;
+      fSlots.emplace_back(id, ring.fLayerID, theta, "single");
+      fScins.emplace_back(
+        id, id, ring.fHeight, ring.fWidth, ring.fLength,
+        radius * std::cos(theta * M_PI / 180.0), radius * std::sin(theta * M_PI / 180.0), 0.0
+      );
+      id++;
+    }
+    nextID = std::max(nextID, id);
+  }
+
+  for (std::size_t i = 0; i < fSlots.size(); i++) {
+    if (!fSlotIndex.emplace(fSlots[i].fID, i).second) {
+      Fail(fileName, "slot " + std::to_string(fSlots[i].fID) + " defined twice");
+      return;
+    }
+    if (!fLayerIndex.count(fSlots[i].fLayerID)) {
+      Fail(fileName, "slot " + std::to_string(fSlots[i].fID) + " refers to a missing layer");
+      return;
+    }
+  }
+
+  std::set<int> scinIDs;
+  for (Scin& scin : fScins) {
+    if (!scinIDs.insert(scin.fID).second) {
+      Fail(fileName, "scintillator " + std::to_string(scin.fID) + " defined twice");
+      return;
+    }
+    if (!fSlotIndex.count(scin.fSlotID)) {
+      Fail(fileName, "scintillator " + std::to_string(scin.fID) + " refers to a missing slot");
+      return;
+    }
+    if (scin.fHeight <= 0 || scin.fWidth <= 0 || scin.fLength <= 0) {
+      Fail(fileName, "scintillator " + std::to_string(scin.fID) + " has no volume");
+      return;
+    }
+    if (std::isnan(scin.fX_center)) {
+      double theta = GetSlotOf(scin).fTheta * M_PI / 180.0;
+      double radius = GetLayerOf(scin).fRadius;
+      scin.fX_center = radius * std::cos(theta);
+      scin.fY_center = radius * std::sin(theta);
+    }
+  }
+
+  //! Barrel format keeps only the angle of the slot - strips of a module written in it share one center
+  std::map<std::tuple<int, long long, long long, long long>, int> centers;
+  for (const Scin& scin : fScins) {
+    auto center = std::make_tuple(
+      GetLayerOf(scin).fID, std::llround(scin.fX_center * 1.e3),
+      std::llround(scin.fY_center * 1.e3), std::llround(scin.fZ_center * 1.e3)
+    );
+    auto inserted = centers.emplace(center, scin.fID);
+    if (!inserted.second) {
+      Fail(
+        fileName, "scintillators " + std::to_string(inserted.first->second) + " and " + std::to_string(scin.fID)
+        + " have the same center; the barrel format does not store the centers of the strips of a module,"
+        + " write the modular layer in the modular format"
+      );
+      return;
+    }
+  }
+
+  //! Solids are built in the order of the file - mothers and components are defined earlier
+  std::set<std::string> solidNames;
+  std::set<std::string> placedNames = {"world"};
+  for (const SolidDescription& solid : fSolids) {
+    std::string name = solid.GetString("name");
+    std::string type = solid.GetString("type");
+    if (name.empty() || name == "world" || !solidNames.insert(name).second) {
+      Fail(fileName, "solid without a name or with a name used twice: '" + name + "'");
+      return;
+    }
+    if (!kSolidTypes.count(type)) {
+      Fail(fileName, "solid " + name + " of unknown type '" + type + "'");
+      return;
+    }
+    if ((type == "union" || type == "subtraction" || type == "intersection")
+      && (!solidNames.count(solid.GetString("first")) || !solidNames.count(solid.GetString("second"))
+      || solid.GetString("first") == name || solid.GetString("second") == name)) {
+      Fail(fileName, "components of the solid " + name + " have to be defined before it");
+      return;
+    }
+    for (const std::string key : {"position", "rotation", "secondPosition", "secondRotation"}) {
+      if (solid.fArrays.count(key) && solid.GetArray(key).size() != 3) {
+        Fail(fileName, key + " of the solid " + name + " needs 3 values");
+        return;
+      }
+    }
+    if (solid.fArrays.count("colour") && solid.GetArray("colour").size() != 3 && solid.GetArray("colour").size() != 4) {
+      Fail(fileName, "colour of the solid " + name + " needs 3 or 4 values");
+      return;
+    }
+    if (type == "polycone" && (solid.GetArray("z").size() < 2
+      || solid.GetArray("rMin").size() != solid.GetArray("z").size()
+      || solid.GetArray("rMax").size() != solid.GetArray("z").size())) {
+      Fail(fileName, "polycone " + name + " needs arrays z, rMin and rMax of the same size");
+      return;
+    }
+    if (type == "stl" && solid.GetString("file").empty()) {
+      Fail(fileName, "stl solid " + name + " without a file");
+      return;
+    }
+    if (solid.Has("material")) {
+      if (!placedNames.count(solid.GetString("mother", "world"))) {
+        Fail(fileName, "mother of the solid " + name + " has to be placed before it");
+        return;
+      }
+      placedNames.insert(name);
+    }
+  }
+
+  G4cout << "----> Geometry description " << fileName << ": " << fLayers.size() << " layers, "
+    << fScins.size() << " scintillators, " << fSolids.size() << " solids" << G4endl;
+}
+
+const Layer& GeometryDescription::GetLayerOf(const Scin& scin) const
+{
+  return fLayers[fLayerIndex.at(GetSlotOf(scin).fLayerID)];
+}
+
+const Slot& GeometryDescription::GetSlotOf(const Scin& scin) const
+{
+  return fSlots[fSlotIndex.at(scin.fSlotID)];
+}
+
+G4bool GeometryDescription::IsWrapped(const Layer& layer) const
+{
+  return std::find(fWrappedLayers.begin(), fWrappedLayers.end(), layer.fID) != fWrappedLayers.end();
+}
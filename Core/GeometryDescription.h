@@ -0,0 +1,109 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file GeometryDescription.h
+ */
+
+#ifndef GEOMETRYDESCRIPTION_H
+#define GEOMETRYDESCRIPTION_H 1
+
+#include <G4Transform3D.hh>
+#include <globals.hh>
+#include <string>
+#include <vector>
+#include <map>
+
+struct Frame {
+  int fID;
+  int fCreatorID;
+  int fVersion;
+  std::string fStatus;
+  std::string fDescription;
+  bool fActive;
+};
+
+struct Layer {
+  int fID;
+  std::string fName;
+  double fRadius;
+  int fSetupID;
+  Layer(int id, const std::string& name, double radius, int setupID) :
+    fID(id), fName(name), fRadius(radius), fSetupID(setupID) {}
+};
+
+struct Slot {
+  int fID;
+  int fLayerID;
+  double fTheta;
+  std::string fType;
+  Slot(int id, int layerID, double theta, const std::string& type) :
+    fID(id), fLayerID(layerID), fTheta(theta), fType(type) {}
+};
+
+struct Scin {
+  int fID;
+  int fSlotID;
+  float fHeight;
+  float fWidth;
+  float fLength;
+  double fX_center;
+  double fY_center;
+  double fZ_center;
+  Scin(int id, int slotID, double height, double width, double length, double x_center, double y_center, double z_center) :
+    fID(id), fSlotID(slotID), fHeight(height), fWidth(width), fLength(length), fX_center(x_center), fY_center(y_center), fZ_center(z_center) {}
+};
+
+//! Entry of the solids list; fields are kept as read, lengths in mm and angles in degrees
+struct SolidDescription {
+  std::map<std::string, std::string> fStrings;
+  std::map<std::string, double> fNumbers;
+  std::map<std::string, std::vector<double>> fArrays;
+
+  std::string GetString(const std::string& key, const std::string& value = "") const;
+  double GetNumber(const std::string& key, double value) const;
+  std::vector<double> GetArray(const std::string& key, const std::vector<double>& value = {}) const;
+  G4bool Has(const std::string& key) const;
+  //! Rotations about x, y and z applied in this order, then the translation
+  G4Transform3D GetTransform(const std::string& positionKey, const std::string& rotationKey) const;
+};
+
+/**
+ * @class GeometryDescription
+ * @brief layers, slots, scintillators and target solids read from a JSON file; accepts both
+ * formats written by CreateGeometryFile (barrel and modular) and rings of equally spaced slots
+ */
+class GeometryDescription
+{
+public:
+  //! Previous content is replaced; unreadable or inconsistent file is a fatal error
+  void Read(const G4String& fileName);
+  const G4String& GetFileName() const { return fFileName; };
+  //! Layer of the slot holding the scintillator
+  const Layer& GetLayerOf(const Scin& scin) const;
+  const Slot& GetSlotOf(const Scin& scin) const;
+  //! Scintillators of the layer are wrapped in kapton (per layer "wrapping", default false)
+  G4bool IsWrapped(const Layer& layer) const;
+
+  std::vector<Layer> fLayers;
+  std::vector<Slot> fSlots;
+  std::vector<Scin> fScins;
+  std::vector<SolidDescription> fSolids;
+
+private:
+  G4String fFileName = "";
+  std::vector<int> fWrappedLayers;
+  //! Position of the layer and of the slot in the vectors by their ID
+  std::map<int, std::size_t> fLayerIndex;
+  std::map<int, std::size_t> fSlotIndex;
+};
+
+#endif /* !GEOMETRYDESCRIPTION_H */
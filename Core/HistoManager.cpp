@@ -15,22 +15,59 @@
 
 #include "../Info/PrimaryParticleInformation.h"
 #include "HistoManager.h"
+#include "EventSeeder.h"
+#include "RunMetrics.h"
+#ifdef JPETMC_WITH_RNTUPLE
+#include "NTupleOutput.h"
+#endif
 
 #include <G4SystemOfUnits.hh>
+#include <G4RunManager.hh>
 #include <G4UnitsTable.hh>
+#include <G4Threading.hh>
+#include <G4AutoLock.hh>
+#include <TFileMerger.h>
+#include <TParameter.h>
+#include <TSystem.h>
+#include <TNamed.h>
+#include <G4Run.hh>
+#include <TROOT.h>
+#include <fstream>
+#include <chrono>
 #include <vector>
 
+namespace
+{
+  //! HistoManagers of the worker threads, merged by the master at the end of the run
+  std::vector<HistoManager*> workerManagers;
+  G4Mutex workerManagersMutex = G4MUTEX_INITIALIZER;
+  //! Output file name chosen by the master and shared by the workers
+  G4String outputFileName;
+}
+
 HistoManager::HistoManager() : fMakeControlHisto(true)
 {
   fEventPack = new JPetGeantEventPack();
   fGeantInfo = fEventPack->GetEventInformation();
 }
 
-HistoManager::~HistoManager() {}
+HistoManager::~HistoManager()
+{
+  delete fWriter;
+#ifdef JPETMC_WITH_RNTUPLE
+  delete fNTupleOutput;
+#endif
+}
 
 void HistoManager::createHistogramWithAxes(
   TObject* object, TString xAxisName, TString yAxisName, TString zAxisName
 ) {
+  //! Histograms are owned by the manager, not by the output file, so they survive
+  //! closing the file and can be merged by the master in the multithreaded mode
+  TH1* histogram = dynamic_cast<TH1*>(object);
+  if (histogram) {
+    histogram->SetDirectory(nullptr);
+  }
   TClass* cl = object->IsA();
   if (cl->InheritsFrom("TH1D")) {
     TH1D* tempHisto = static_cast<TH1D*>(object);
@@ -49,6 +86,38 @@ void HistoManager::createHistogramWithAxes(
   fStats.Add(object);
 }
 
+H1Handle HistoManager::BookH1(TH1D* histogram, TString xAxisName, TString yAxisName)
+{
+  createHistogramWithAxes(histogram, xAxisName, yAxisName);
+  H1Handle handle;
+  handle.fIndex = fHistograms.size();
+  fHistograms.push_back(histogram);
+  fAccumulators.emplace_back(histogram);
+  return handle;
+}
+
+H2Handle HistoManager::BookH2(TH2D* histogram, TString xAxisName, TString yAxisName)
+{
+  createHistogramWithAxes(histogram, xAxisName, yAxisName);
+  H2Handle handle;
+  handle.fIndex = fHistograms.size();
+  fHistograms.push_back(histogram);
+  fAccumulators.emplace_back(histogram);
+  return handle;
+}
+
+/**
+ * Histograms are filled through plain bin arrays of the thread and get their content,
+ * entries and statistics only here, so filling needs neither ROOT nor locking
+ */
+void HistoManager::ReduceHistograms()
+{
+  for (std::size_t i = 0; i < fHistograms.size(); i++) {
+    fAccumulators[i].AddTo(fHistograms[i]);
+  }
+}
+
+//! Lookup by name, kept for scripts; the simulation fills through the handles
 void HistoManager::fillHistogram(
   const char* name, double xValue, doubleCheck yValue, doubleCheck zValue
 ) {
@@ -86,6 +155,91 @@ void HistoManager::Book()
 {
   if (fBookStatus) return;
 
+  if (G4Threading::IsMasterThread()) {
+    fFileName = CreateFileName();
+    outputFileName = fFileName;
+  } else {
+    //! Each worker thread writes its own part of the output
+    fFileName = outputFileName;
+    fFileName.insert(fFileName.rfind(".root"), "_t" + std::to_string(G4Threading::G4GetThreadId()));
+    G4AutoLock lock(&workerManagersMutex);
+    workerManagers.push_back(this);
+  }
+
+  if (IsMergingManager()) {
+    //! Master does not track events, it only collects the output of the workers
+    if (GetMakeControlHisto()) BookHistograms();
+    fBookStatus = true;
+    return;
+  }
+
+  fRootFile = new TFile(fFileName, "RECREATE");
+  if (!fRootFile) {
+    G4cout << " HistoManager::Book :" << " problem creating the ROOT TFile " << G4endl;
+    return;
+  }
+  G4int compression = fEvtMessenger->GetCompressionSettings();
+  if (compression >= 0) fRootFile->SetCompressionSettings(compression);
+
+  bool useNTuple = fEvtMessenger->UseRNTuple();
+#ifndef JPETMC_WITH_RNTUPLE
+  if (useNTuple) {
+    G4Exception("HistoManager", "HM02", JustWarning, "RNTuple output requires ROOT 6.32 or newer, TTree is written");
+    useNTuple = false;
+  }
+#endif
+
+  Int_t bufsize = fEvtMessenger->GetBasketSize();
+  Int_t splitlevel = fEvtMessenger->GetSplitLevel();
+
+  if (useNTuple) {
+#ifdef JPETMC_WITH_RNTUPLE
+    fNTupleOutput = new NTupleOutput(
+      *fRootFile, compression, fEvtMessenger->StorePolarization(), fEvtMessenger->StoreMomentum()
+    );
+#endif
+  } else {
+    fTree = new TTree("T", "Tree keeps output from Geant simulation", splitlevel);
+    //! autosave when 1 Gbyte written
+    fTree->SetAutoSave(1000000000);
+    fTree->SetAutoFlush(fEvtMessenger->GetAutoFlush());
+  }
+  fWriteTime = 0.0;
+  fWrittenEvents = 0;
+  fRejectedEvents = 0;
+  fRejectedBeforeTracking = 0;
+  fUnselectedEvents = 0;
+
+  //! Branch reads the pack being written, in asynchronous mode it is set by the writer thread
+  JPetGeantEventPack** writtenPack = &fEventPack;
+  if (fEvtMessenger->UseAsyncWriter()) {
+    ROOT::EnableThreadSafety();
+    fWriter = new EventPackWriter(
+      [this](JPetGeantEventPack* pack) { fWriterPack = pack; WriteEvent(pack); },
+      fEvtMessenger->GetWriterQueueSize()
+    );
+    //! Packs of the ring are owned by the writer, the one of the direct mode is not needed
+    delete fEventPack;
+    fEventPack = fWriter->Acquire();
+    fGeantInfo = fEventPack->GetEventInformation();
+    fWriterPack = fEventPack;
+    writtenPack = &fWriterPack;
+  }
+  if (fTree) {
+    fBranchEventPack = fTree->Branch("eventPack", writtenPack, bufsize, splitlevel);
+  }
+
+  if (GetMakeControlHisto()) BookHistograms();
+  fBookStatus = true;
+}
+
+bool HistoManager::IsMergingManager() const
+{
+  return G4Threading::IsMultithreadedApplication() && G4Threading::IsMasterThread();
+}
+
+G4String HistoManager::CreateFileName() const
+{
   G4String fileName = "mcGeant.root";
 
   if (fEvtMessenger->AddDatetime()) {
@@ -116,108 +270,155 @@ void HistoManager::Book()
       + a_hour + "_" + a_minute + "_" + a_second;
     fileName = dateTime + "." + fileName;
   }
+  if (fEvtMessenger->IsSharded()) {
+    //! Index padded to the width of the number of shards keeps the files sorted
+    std::string index = std::to_string(fEvtMessenger->GetShardIndex());
+    std::size_t width = std::to_string(fEvtMessenger->GetShardCount() - 1).length();
+    index.insert(0, width - index.length(), '0');
+    fileName.insert(fileName.rfind(".root"), "_shard" + index);
+  }
+  return fileName;
+}
 
-  fRootFile = new TFile(fileName, "RECREATE");
-  if (!fRootFile) {
-    G4cout << " HistoManager::Book :" << " problem creating the ROOT TFile " << G4endl;
-    return;
+void HistoManager::SaveEvtPack()
+{
+  if (fWriter) {
+    fWriter->Submit(fEventPack);
+    fEventPack = fWriter->Acquire();
+    fGeantInfo = fEventPack->GetEventInformation();
+  } else {
+    WriteEvent(fEventPack);
   }
+}
 
-  Int_t bufsize = 32000;
-  Int_t splitlevel = 2;
+void HistoManager::AddRejectedEvent(bool beforeTracking)
+{
+  fRejectedEvents++;
+  if (beforeTracking) fRejectedBeforeTracking++;
+}
 
-  fTree = new TTree("T", "Tree keeps output from Geant simulation", splitlevel);
-  //! autosave when 1 Gbyte written
-  fTree->SetAutoSave(1000000000);
-  fBranchEventPack = fTree->Branch("eventPack", &fEventPack, bufsize, splitlevel);
+void HistoManager::WriteEvent(JPetGeantEventPack* pack)
+{
+  auto start = std::chrono::steady_clock::now();
+  if (fNTupleOutput) {
+#ifdef JPETMC_WITH_RNTUPLE
+    fNTupleOutput->Fill(*pack);
+#endif
+  } else {
+    fTree->Fill();
+  }
+  fWriteTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  fWrittenEvents++;
+}
 
-  if (GetMakeControlHisto()) BookHistograms();
-  fBookStatus = true;
+/**
+ * Time spent in writing the events includes streaming, compression and writing
+ * of the baskets, so it measures the cost of the output settings only
+ */
+void HistoManager::PrintOutputStatistics() const
+{
+  if (fWrittenEvents == 0) return;
+  //! RNTuple is the only content of the file apart from the histograms written later
+  double zipBytes = fTree ? fTree->GetZipBytes() : fRootFile->GetEND();
+  G4cout << "\n----> Output: " << fWrittenEvents << " events, " << zipBytes / fWrittenEvents << " bytes/event";
+  if (fTree) {
+    double totBytes = fTree->GetTotBytes();
+    G4cout << " (" << totBytes / fWrittenEvents << " uncompressed, compression factor "
+      << (zipBytes > 0 ? totBytes / zipBytes : 0.0) << ")";
+  }
+  G4cout << G4endl;
+  if (fWriteTime > 0.0) {
+    G4cout << "----> Output rate: " << zipBytes / fWriteTime / 1.e6 << " MB/s written";
+    if (fTree) G4cout << ", " << fTree->GetTotBytes() / fWriteTime / 1.e6 << " MB/s uncompressed";
+    G4cout << " (" << fWriteTime << " s)" << G4endl;
+  }
 }
 
 void HistoManager::BookHistograms()
 {
-  createHistogramWithAxes(
+  fHistograms.clear();
+  fAccumulators.clear();
+  fGenGammaMultiplicity = BookH1(
     new TH1D("gen_gamma_multiplicity", "Generated gammas multiplicity", 10, -0.5, 9.5),
     "Gamma quanta multiplicity: 1=prompt; 2=2g; 3=3g", "Entries"
   );
 
-  createHistogramWithAxes(
+  fGenHitTime = BookH1(
     new TH1D("gen_hit_time", "Generated hit time", 100, -75.0, 14925.0),
     "Hit-times in scintillators [ps]", "Entries"
   );
 
-  createHistogramWithAxes(
+  fGenHitEneDepos = BookH1(
     new TH1D("gen_hit_eneDepos", "Generated hit energy deposition", 750, -1.0, 1499.0),
     "Deposited energy in scintillators [keV]", "Entries"
   );
 
-  createHistogramWithAxes(
+  fGenHitsZPos = BookH1(
     new TH1D("gen_hits_z_pos", "Generated hits Z position", 120, -59.5, 60.5),
     "Hit-position along Z [cm]", "Entries"
   );
 
-  createHistogramWithAxes(
+  fGenHitsXYPos = BookH2(
     new TH2D("gen_hits_xy_pos", "Generated hits XY positions", 120, -59.5, 60.5, 120, -59.5, 60.5),
     "Hit-position X [cm]", "Hit-position Y [cm]"
   );
 
-  createHistogramWithAxes(
+  fGenLifetime = BookH1(
     new TH1D("gen_lifetime", "Generated lifetime", 2000, -50.0, 199950.0),
     "Lifetime (2/3g) [ps]", "Entries"
   );
 
-  createHistogramWithAxes(
+  fGenPromptLifetime = BookH1(
     new TH1D("gen_prompt_lifetime", "Gen prompt lifetime", 100, -5.0, 995.0),
     "Lifetime prompt gamma [ps]", "Entries"
   );
 
-  createHistogramWithAxes(
+  fGenXY = BookH2(
     new TH2D("gen_XY", "Generated XY coordinates of annihilation point", 50, -24.5, 25.5, 50, -24.5, 25.5),
     "Annihilation point (2/3g) X [cm]", "Annihilation point (2/3g) Y [cm]"
   );
 
-  createHistogramWithAxes(
+  fGenXZ = BookH2(
     new TH2D("gen_XZ", "Generated XZ coordinates of annihilation point", 50, -24.5, 25.5, 120, -59.5, 60.5),
     "Annihilation point (2/3g) X [cm]", "Annihilation point (2/3g) Z [cm]"
   );
 
-  createHistogramWithAxes(
+  fGenYZ = BookH2(
     new TH2D("gen_YZ", "Generated YZ coordinates of annihilation point", 50, -24.5, 25.5, 120, -59.5, 60.5),
     "Annihilation point (2/3g) Y [cm]", "Annihilation point (2/3g) Z [cm]"
   );
 
-  createHistogramWithAxes(
+  fGenPromptXY = BookH2(
     new TH2D("gen_prompt_XY", "Generated XY coordinates of annihilation point", 50, -24.5, 25.5, 50, -24.5, 25.5),
     "Prompt emission point X [cm]", "Prompt emission point Y [cm]"
   );
 
-  createHistogramWithAxes(
+  fGenPromptXZ = BookH2(
     new TH2D("gen_prompt_XZ", "Generated XZ coordinates of annihilation point", 50, -24.5, 25.5, 120, -59.5, 60.5),
     "Prompt emission point X [cm]", "Prompt emission point Z [cm]"
   );
 
-  createHistogramWithAxes(
+  fGenPromptYZ = BookH2(
     new TH2D("gen_prompt_YZ", "Generated YZ coordinates of annihilation point", 50, -24.5, 25.5, 120, -59.5, 60.5),
     "Prompt emission point Y [cm]", "Prompt emission point Z [cm]"
   );
 
-  createHistogramWithAxes(
+  fGen3gAngles = BookH2(
     new TH2D("gen_3g_angles", "Generated angles of 3g", 190, -0.5, 189.5, 190, -0.5, 189.5),
     "#Theta_{12} [degree]", "#Theta_{23} [degree]"
   );
 
-  createHistogramWithAxes(
+  fGenEnergy = BookH2(
     new TH2D("gen_energy", "Generated energy of 3g", 120, -2.5, 597.5, 120, -2.5, 597.5),
     "E_1 [keV]", "E_2 [keV]"
   );
 
-  createHistogramWithAxes(
+  fGenGEne = BookH1(
     new TH1D("gen_g_ene", "Generated energy", 300, -2.5, 1497.5),
     "E_1 generated [keV]", "Entries"
   );
 
-  createHistogramWithAxes(
+  fGenGammaMultiplicityVsLifetime = BookH2(
     new TH2D(
       "gen_gamma_multiplicity_vs_lifetime",
       "Generated gammas multiplicity vs generated lifetime",
@@ -226,7 +427,7 @@ void HistoManager::BookHistograms()
     "Gamma quanta multiplicity: 2=2g; 3=3g", "Lifetime (2/3g) [ps]"
   );
   
-  createHistogramWithAxes(
+  fGenHitsMultiplicity = BookH1(
     new TH1D("gen_hits_multiplicity", "Multiplicity of the hit", 3000, -0.5, 2999.5),
     "Multiplicity of the hit", "Entries"
   );
@@ -251,9 +452,9 @@ void HistoManager::FillHistoGenInfo(const G4Event* anEvent)
   double theta_12 = (180. / TMath::Pi()) * (fGeantInfo->GetMomentumGamma(1)).Angle(fGeantInfo->GetMomentumGamma(2));
   double theta_23 = (180. / TMath::Pi()) * (fGeantInfo->GetMomentumGamma(2)).Angle(fGeantInfo->GetMomentumGamma(3));
 
-  fillHistogram("gen_3g_angles", theta_12, doubleCheck(theta_23));
-  fillHistogram("gen_energy", fGeantInfo->GetMomentumGamma(1).Mag(), doubleCheck(fGeantInfo->GetMomentumGamma(2).Mag()));
-  fillHistogram("gen_g_ene", fGeantInfo->GetMomentumGamma(1).Mag());
+  Fill(fGen3gAngles, theta_12, theta_23);
+  Fill(fGenEnergy, fGeantInfo->GetMomentumGamma(1).Mag(), fGeantInfo->GetMomentumGamma(2).Mag());
+  Fill(fGenGEne, fGeantInfo->GetMomentumGamma(1).Mag());
   
 }
 
@@ -289,17 +490,17 @@ void HistoManager::AddGenInfo(VtxInformation* info)
 
     if (GetMakeControlHisto()) {
       if (is2g) {
-        fillHistogram("gen_gamma_multiplicity", 2);
-        fillHistogram("gen_gamma_multiplicity_vs_lifetime", 2, doubleCheck(info->GetLifetime() / ps));
+        Fill(fGenGammaMultiplicity, 2);
+        Fill(fGenGammaMultiplicityVsLifetime, 2, info->GetLifetime() / ps);
       }
       if (is3g) {
-        fillHistogram("gen_gamma_multiplicity", 3);
-        fillHistogram("gen_gamma_multiplicity_vs_lifetime", 3, doubleCheck(info->GetLifetime() / ps));
+        Fill(fGenGammaMultiplicity, 3);
+        Fill(fGenGammaMultiplicityVsLifetime, 3, info->GetLifetime() / ps);
       }
-      fillHistogram("gen_lifetime", info->GetLifetime() / ps);
-      fillHistogram("gen_XY", info->GetVtxPositionX() / cm, doubleCheck(info->GetVtxPositionY() / cm));
-      fillHistogram("gen_XZ", info->GetVtxPositionX() / cm, doubleCheck(info->GetVtxPositionZ() / cm));
-      fillHistogram("gen_YZ", info->GetVtxPositionY() / cm, doubleCheck(info->GetVtxPositionZ() / cm));
+      Fill(fGenLifetime, info->GetLifetime() / ps);
+      Fill(fGenXY, info->GetVtxPositionX() / cm, info->GetVtxPositionY() / cm);
+      Fill(fGenXZ, info->GetVtxPositionX() / cm, info->GetVtxPositionZ() / cm);
+      Fill(fGenYZ, info->GetVtxPositionY() / cm, info->GetVtxPositionZ() / cm);
     }
   }
 
@@ -312,11 +513,11 @@ void HistoManager::AddGenInfo(VtxInformation* info)
     fGeantInfo->SetRunNr(info->GetRunNr());
 
     if (GetMakeControlHisto()) {
-      fillHistogram("gen_gamma_multiplicity", 1);
-      fillHistogram("gen_prompt_lifetime", info->GetLifetime() / ps);
-      fillHistogram("gen_prompt_XY", info->GetVtxPositionX() / cm, doubleCheck(info->GetVtxPositionY() / cm));
-      fillHistogram("gen_prompt_XZ", info->GetVtxPositionX() / cm, doubleCheck(info->GetVtxPositionZ() / cm));
-      fillHistogram("gen_prompt_YZ", info->GetVtxPositionY() / cm, doubleCheck(info->GetVtxPositionZ() / cm));
+      Fill(fGenGammaMultiplicity, 1);
+      Fill(fGenPromptLifetime, info->GetLifetime() / ps);
+      Fill(fGenPromptXY, info->GetVtxPositionX() / cm, info->GetVtxPositionY() / cm);
+      Fill(fGenPromptXZ, info->GetVtxPositionX() / cm, info->GetVtxPositionZ() / cm);
+      Fill(fGenPromptYZ, info->GetVtxPositionY() / cm, info->GetVtxPositionZ() / cm);
     }
   }
   SetParentIDofPhoton(0);
@@ -336,31 +537,43 @@ void HistoManager::AddNewHit(DetectorHit* hit)
   geantHit->SetHitPosition(
     hit->GetPosition().getX()/cm, hit->GetPosition().getY()/cm, hit->GetPosition().getZ()/cm
   );
-  geantHit->SetPolarizationIn(
-    hit->GetPolarizationIn().getX(), hit->GetPolarizationIn().getY(),
-    hit->GetPolarizationIn().getZ()
-  );
-  geantHit->SetPolarizationOut(
-    hit->GetPolarizationOut().getX(), hit->GetPolarizationOut().getY(),
-    hit->GetPolarizationOut().getZ()
-  );
-  geantHit->SetMomentumIn(
-    hit->GetMomentumIn().getX()/keV, hit->GetMomentumIn().getY()/keV,
-    hit->GetMomentumIn().getZ()/keV
-  );
-  geantHit->SetMomentumOut(
-    hit->GetMomentumOut().getX()/keV, hit->GetMomentumOut().getY()/keV,
-    hit->GetMomentumOut().getZ()/keV
-  );
+  //! Hits are reused between events, so switched off groups are reset to zero,
+  //! which costs almost nothing after compression
+  if (fEvtMessenger->StorePolarization()) {
+    geantHit->SetPolarizationIn(
+      hit->GetPolarizationIn().getX(), hit->GetPolarizationIn().getY(),
+      hit->GetPolarizationIn().getZ()
+    );
+    geantHit->SetPolarizationOut(
+      hit->GetPolarizationOut().getX(), hit->GetPolarizationOut().getY(),
+      hit->GetPolarizationOut().getZ()
+    );
+  } else {
+    geantHit->SetPolarizationIn(0.0f, 0.0f, 0.0f);
+    geantHit->SetPolarizationOut(0.0f, 0.0f, 0.0f);
+  }
+  if (fEvtMessenger->StoreMomentum()) {
+    geantHit->SetMomentumIn(
+      hit->GetMomentumIn().getX()/keV, hit->GetMomentumIn().getY()/keV,
+      hit->GetMomentumIn().getZ()/keV
+    );
+    geantHit->SetMomentumOut(
+      hit->GetMomentumOut().getX()/keV, hit->GetMomentumOut().getY()/keV,
+      hit->GetMomentumOut().getZ()/keV
+    );
+  } else {
+    geantHit->SetMomentumIn(0.0f, 0.0f, 0.0f);
+    geantHit->SetMomentumOut(0.0f, 0.0f, 0.0f);
+  }
   geantHit->SetGenGammaMultiplicity(hit->GetGenGammaMultiplicity());
   geantHit->SetGenGammaIndex(hit->GetGenGammaIndex());
   
   if (GetMakeControlHisto()) {
-    fillHistogram("gen_hit_time", hit->GetTime()/ps);
-    fillHistogram("gen_hit_eneDepos", hit->GetEdep()/keV);
-    fillHistogram("gen_hits_z_pos", hit->GetPosition().getZ()/cm);
-    fillHistogram("gen_hits_xy_pos", hit->GetPosition().getX()/cm, doubleCheck(hit->GetPosition().getY()/cm));
-    fillHistogram("gen_hits_multiplicity", hit->GetGenGammaMultiplicity());
+    Fill(fGenHitTime, hit->GetTime()/ps);
+    Fill(fGenHitEneDepos, hit->GetEdep()/keV);
+    Fill(fGenHitsZPos, hit->GetPosition().getZ()/cm);
+    Fill(fGenHitsXYPos, hit->GetPosition().getX()/cm, hit->GetPosition().getY()/cm);
+    Fill(fGenHitsMultiplicity, hit->GetGenGammaMultiplicity());
   }
 }
 
@@ -397,17 +610,176 @@ void HistoManager::AddNodeToDecayTree(int nodeID, int trackID)
 
 void HistoManager::Save()
 {
+  if (IsMergingManager()) {
+    MergeWorkers();
+    return;
+  }
+  ReduceHistograms();
   if (!fRootFile) return;
-  fTree->Write();
-  if (GetMakeControlHisto()) {
+  if (fWriter) {
+    fWriter->Stop();
+    G4cout << "\n----> Writer thread: " << fWriter->GetWrittenPacks() << " events written, tracking waited "
+      << fWriter->GetBackPressureCount() << " times (" << fWriter->GetBackPressureTime()
+      << " s) for a free event pack" << G4endl;
+  }
+  fRootFile->cd();
+  auto start = std::chrono::steady_clock::now();
+  if (fNTupleOutput) {
+#ifdef JPETMC_WITH_RNTUPLE
+    fNTupleOutput->Close();
+#endif
+  } else {
+    fTree->Write();
+  }
+  fWriteTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  PrintOutputStatistics();
+  FillRunMetrics();
+  WriteRejectedEvents();
+  //! Histograms of the workers are added up and written by the master
+  if (GetMakeControlHisto() && !G4Threading::IsWorkerThread()) {
     TIterator* it = fStats.MakeIterator();
     TObject* obj;
     while ((obj = it->Next())) obj->Write();
   }
+  if (!G4Threading::IsWorkerThread()) {
+    WriteShardInfo();
+    WriteRunMetrics();
+  }
   fRootFile->Close();
   G4cout << "\n----> Histograms and ntuples are saved\n" << G4endl;
 }
 
+/**
+ * Histograms of the workers are added bin by bin, the trees from the worker files
+ * are concatenated by copying the compressed baskets, without reading the events.
+ * Event numbers are the global Geant4 event IDs, so they are unique in the merged tree.
+ */
+void HistoManager::MergeWorkers()
+{
+  G4AutoLock lock(&workerManagersMutex);
+  auto start = std::chrono::steady_clock::now();
+  TFileMerger merger(kFALSE);
+  merger.SetFastMethod(kTRUE);
+  G4int compression = fEvtMessenger->GetCompressionSettings();
+  //! Baskets are copied without recompression only if the settings match the worker files
+  if (compression >= 0) {
+    merger.OutputFile(fFileName, "RECREATE", compression);
+  } else {
+    merger.OutputFile(fFileName, "RECREATE");
+  }
+  for (HistoManager* worker : workerManagers) {
+    merger.AddFile(worker->fFileName, kFALSE);
+    if (!GetMakeControlHisto()) continue;
+    TIter next(&worker->fStats);
+    TObject* obj;
+    while ((obj = next())) {
+      TH1* histogram = getObject<TH1>(obj->GetName());
+      if (histogram) histogram->Add(static_cast<TH1*>(obj));
+    }
+  }
+  if (!merger.Merge()) {
+    G4Exception("HistoManager", "HM01", JustWarning, "Merging of the worker output files failed");
+    return;
+  }
+
+  for (HistoManager* worker : workerManagers) {
+    gSystem->Unlink(worker->fFileName);
+  }
+  RunMetrics::GetInstance()->AddTime(
+    "output.merge", std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+  );
+
+  TFile* file = new TFile(fFileName, "UPDATE");
+  if (GetMakeControlHisto()) {
+    TIter next(&fStats);
+    TObject* obj;
+    while ((obj = next())) obj->Write();
+  }
+  WriteShardInfo();
+  WriteRunMetrics();
+  file->Close();
+  delete file;
+  workerManagers.clear();
+  G4cout << "\n----> Histograms and ntuples of the worker threads are merged\n" << G4endl;
+}
+
+/**
+ * Range of event IDs covered by the shard is kept in a small tree, so that it is
+ * concatenated by merging and jpet_mc_merge can check merged files for duplicates
+ */
+void HistoManager::WriteShardInfo()
+{
+  if (!fEvtMessenger->IsSharded()) return;
+  Int_t shardIndex = fEvtMessenger->GetShardIndex();
+  Int_t shardCount = fEvtMessenger->GetShardCount();
+  Long64_t runSeed = EventSeeder::GetRunSeed();
+  Long64_t firstEvent = EventSeeder::GetEventOffset();
+  Long64_t numberOfEvents = G4RunManager::GetRunManager()->GetCurrentRun()->GetNumberOfEventToBeProcessed();
+  TTree* shards = new TTree("Shards", "Event ranges of the shards merged into the file");
+  shards->Branch("shardIndex", &shardIndex, "shardIndex/I");
+  shards->Branch("shardCount", &shardCount, "shardCount/I");
+  shards->Branch("runSeed", &runSeed, "runSeed/L");
+  shards->Branch("firstEvent", &firstEvent, "firstEvent/L");
+  shards->Branch("numberOfEvents", &numberOfEvents, "numberOfEvents/L");
+  shards->Fill();
+  shards->Write();
+  delete shards;
+}
+
+void HistoManager::WriteRejectedEvents()
+{
+  if (fEvtMessenger->KillEventsEscapingWorld()) {
+    G4cout << "\n----> Rejected events: " << fRejectedEvents << " (" << fRejectedBeforeTracking
+      << " before tracking by the acceptance filter)" << G4endl;
+    TParameter<Long64_t> rejected("rejectedEvents", fRejectedEvents);
+    TParameter<Long64_t> rejectedBeforeTracking("rejectedEventsBeforeTracking", fRejectedBeforeTracking);
+    rejected.Write();
+    rejectedBeforeTracking.Write();
+  }
+  if (fEvtMessenger->Save2g() || fEvtMessenger->Save3g()) {
+    G4cout << "----> Events not selected by save2g/save3g: " << fUnselectedEvents << G4endl;
+    TParameter<Long64_t> unselected("unselectedEvents", fUnselectedEvents);
+    unselected.Write();
+  }
+}
+
+void HistoManager::FillRunMetrics() const
+{
+  RunMetrics* metrics = RunMetrics::GetInstance();
+  metrics->Add("output.events", fWrittenEvents);
+  metrics->AddTime("output.write", fWriteTime, fWrittenEvents);
+  if (fTree) {
+    metrics->Add("output.zipBytes", fTree->GetZipBytes());
+    metrics->Add("output.totBytes", fTree->GetTotBytes());
+  } else {
+    metrics->Add("output.zipBytes", fRootFile->GetEND());
+  }
+  if (fWriter) {
+    metrics->Add("output.writerBackPressure", fWriter->GetBackPressureCount());
+    metrics->AddTime("output.writerBackPressure", fWriter->GetBackPressureTime(), fWriter->GetBackPressureCount());
+  }
+}
+
+/**
+ * Metrics are stored as a JSON string in the title of a TNamed and in a file named after the
+ * output file, so that they can be read without ROOT; called by the master only
+ */
+void HistoManager::WriteRunMetrics()
+{
+  std::string json = RunMetrics::ToJSON();
+  TNamed metrics("runMetrics", json.c_str());
+  metrics.Write();
+  G4String jsonFileName = fFileName;
+  jsonFileName.replace(jsonFileName.rfind(".root"), 5, "_metrics.json");
+  std::ofstream jsonFile(jsonFileName);
+  if (!jsonFile) {
+    G4Exception("HistoManager", "HM03", JustWarning, ("Can not write the run metrics to " + jsonFileName).c_str());
+    return;
+  }
+  jsonFile << json;
+  G4cout << "\n----> Run metrics are saved to " << jsonFileName << G4endl;
+}
+
 void HistoManager::writeError(const char* nameOfHistogram, const char* messageEnd)
 {
   std::string histName(nameOfHistogram);
@@ -23,6 +23,8 @@
 #include "../Objects/Geant4/DetectorHit.h"
 #include "../Info/EventMessenger.h"
 #include "../Info/VtxInformation.h"
+#include "HistogramAccumulator.h"
+#include "EventPackWriter.h"
 
 #include <G4PrimaryParticle.hh>
 #include <THashTable.h>
@@ -33,7 +35,9 @@
 #include <TH1F.h>
 #include <TH2F.h>
 #include <TH3F.h>
+#include <vector>
 
+class NTupleOutput;
 class TFile;
 class TTree;
 
@@ -48,6 +52,10 @@ struct doubleCheck
   }
 };
 
+//! Index of a booked histogram; filling through it needs no lookup by name
+struct H1Handle { int fIndex = -1; };
+struct H2Handle { int fIndex = -1; };
+
 /**
  * @class HistoManager
  * @brief class reach for informations stored during sumulations
@@ -61,7 +69,11 @@ public:
   
   void Book(); //! call once; book (create) all trees and histograms
   void Save(); //! call once; save all trees and histograms
-  void SaveEvtPack() { fTree->Fill(); };
+  void SaveEvtPack();
+  //! Counts event killed with saveEvtsDetAcc, needed for normalization of the stored events
+  void AddRejectedEvent(bool beforeTracking);
+  //! Counts event aborted by save2g/save3g - without the requested decay, lost in flight or not registered
+  void AddUnselectedEvent() { fUnselectedEvents++; };
   void Clear() { fEventPack->Clear(); };
   void AddGenInfo(VtxInformation* info);
   void AddGenInfoParticles(G4PrimaryParticle* particle);
@@ -69,8 +81,8 @@ public:
   void AddNodeToDecayTree(int nodeID, int trackID);
   void SetParentIDofPhoton(int x) { fParentIDofPhoton = x; };
   int GetParentIDofPhoton() const { return fParentIDofPhoton; };
-  void SetEventNumber(int x) { fEventPack->SetEventNumber(x); };
-  int GetEventNumber() { return fEventPack->GetEventNumber(); };
+  void SetEventNumber(Long64_t x) { fEventPack->SetEventNumber(x); };
+  Long64_t GetEventNumber() { return fEventPack->GetEventNumber(); };
   void SetHistogramCreation(bool tf) { fMakeControlHisto = tf; };
   bool GetMakeControlHisto() const { return fMakeControlHisto; };
   void FillHistoGenInfo(const G4Event* anEvent);
@@ -86,6 +98,16 @@ public:
     const char* name, double xValue, doubleCheck yValue = doubleCheck(), doubleCheck zValue = doubleCheck()
   );
   void writeError(const char* nameOfHistogram, const char* messageEnd);
+  //! Registers the histogram like createHistogramWithAxes and returns its handle
+  H1Handle BookH1(TH1D* histogram, TString xAxisName, TString yAxisName);
+  H2Handle BookH2(TH2D* histogram, TString xAxisName, TString yAxisName);
+  //! Fills the bin arrays of this thread, histograms that were not booked are skipped
+  void Fill(H1Handle handle, double xValue) {
+    if (handle.fIndex >= 0) fAccumulators[handle.fIndex].Fill(xValue);
+  };
+  void Fill(H2Handle handle, double xValue, double yValue) {
+    if (handle.fIndex >= 0) fAccumulators[handle.fIndex].Fill(xValue, yValue);
+  };
 
   template <typename T>
   T* getObject(const char* name) {
@@ -98,22 +120,75 @@ public:
 
 private:
   HistoManager(const HistoManager &histoManagerToCopy);
+  //! Name of the output file with date and time if requested
+  G4String CreateFileName() const;
+  //! True for the master in the multithreaded mode, which only merges outputs of the workers
+  bool IsMergingManager() const;
+  void MergeWorkers();
+  //! Writes the event to the output and accumulates the time spent in it
+  void WriteEvent(JPetGeantEventPack* pack);
+  //! Prints size per event and output rate for the chosen compression settings
+  void PrintOutputStatistics() const;
+  //! Writes the range of event IDs of the shard into the current file
+  void WriteShardInfo();
+  //! Writes the numbers of rejected and unselected events, they are summed up when the files are merged
+  void WriteRejectedEvents();
+  //! Adds the output sizes and write time of the thread to the run metrics
+  void FillRunMetrics() const;
+  //! Writes the metrics of all threads into the current file and into a JSON file next to it
+  void WriteRunMetrics();
 
   int fParentIDofPhoton = 0;
   bool fEndOfEvent = true;
   bool fBookStatus = false;
   bool fMakeControlHisto = false;
+  G4String fFileName;
+  //! Time spent in filling and writing the tree [s]
+  double fWriteTime = 0.0;
+  Long64_t fWrittenEvents = 0;
+  //! Events killed with saveEvtsDetAcc, in total and by the acceptance filter before tracking
+  Long64_t fRejectedEvents = 0;
+  Long64_t fRejectedBeforeTracking = 0;
+  Long64_t fUnselectedEvents = 0;
   TFile* fRootFile = nullptr;
   TTree* fTree = nullptr;
+  //! RNTuple output, used instead of the tree if requested
+  NTupleOutput* fNTupleOutput = nullptr;
   TBranch* fBranchTrk = nullptr;
   TBranch* fBranchScin = nullptr;
   TBranch* fBranchEventPack = nullptr;
 
   JPetGeantEventPack* fEventPack = nullptr;
+  //! Asynchronous output: pack currently written by the writer thread
+  JPetGeantEventPack* fWriterPack = nullptr;
+  EventPackWriter* fWriter = nullptr;
   JPetGeantEventInformation* fGeantInfo = nullptr;
   EventMessenger* fEvtMessenger = EventMessenger::GetEventMessenger();
 
   void BookHistograms();
+  //! Adds the bin arrays to the ROOT histograms, called when they are saved
+  void ReduceHistograms();
+  //! Booked histograms and their bin arrays, indexed by the handles
+  std::vector<TH1*> fHistograms;
+  std::vector<HistogramAccumulator> fAccumulators;
+  H1Handle fGenGammaMultiplicity;
+  H1Handle fGenHitTime;
+  H1Handle fGenHitEneDepos;
+  H1Handle fGenHitsZPos;
+  H2Handle fGenHitsXYPos;
+  H1Handle fGenLifetime;
+  H1Handle fGenPromptLifetime;
+  H2Handle fGenXY;
+  H2Handle fGenXZ;
+  H2Handle fGenYZ;
+  H2Handle fGenPromptXY;
+  H2Handle fGenPromptXZ;
+  H2Handle fGenPromptYZ;
+  H2Handle fGen3gAngles;
+  H2Handle fGenEnergy;
+  H1Handle fGenGEne;
+  H2Handle fGenGammaMultiplicityVsLifetime;
+  H1Handle fGenHitsMultiplicity;
 
 protected:
   THashTable fStats;
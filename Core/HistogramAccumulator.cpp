@@ -0,0 +1,99 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file HistogramAccumulator.cpp
+ */
+
+#include "HistogramAccumulator.h"
+
+#include <algorithm>
+
+HistogramAccumulator::HistogramAccumulator(const TH1* histogram)
+{
+  const TAxis* xAxis = histogram->GetXaxis();
+  const TAxis* yAxis = histogram->GetYaxis();
+  fX = {xAxis->GetNbins(), xAxis->GetXmin(), xAxis->GetXmax()};
+  fY = {0, 0.0, 0.0};
+  if (histogram->GetDimension() > 1) {
+    fY = {yAxis->GetNbins(), yAxis->GetXmin(), yAxis->GetXmax()};
+  }
+  fContent.assign((fX.fBins + 2) * (fY.fBins + 2), 0.0);
+}
+
+int HistogramAccumulator::Axis::FindBin(double value) const
+{
+  if (value < fMin) return 0;
+  if (!(value < fMax)) return fBins + 1;
+  return 1 + int(fBins * (value - fMin) / (fMax - fMin));
+}
+
+//! Entries count every fill, the statistics only fills inside the axis range, as in TH1::Fill
+void HistogramAccumulator::Fill(double x)
+{
+  int bin = fX.FindBin(x);
+  fContent[bin] += 1.0;
+  fEntries += 1.0;
+  if (bin == 0 || bin > fX.fBins) return;
+  fStats[0] += 1.0;
+  fStats[1] += 1.0;
+  fStats[2] += x;
+  fStats[3] += x * x;
+}
+
+void HistogramAccumulator::Fill(double x, double y)
+{
+  int binX = fX.FindBin(x);
+  int binY = fY.FindBin(y);
+  fContent[binX + (fX.fBins + 2) * binY] += 1.0;
+  fEntries += 1.0;
+  if (binX == 0 || binX > fX.fBins || binY == 0 || binY > fY.fBins) return;
+  fStats[0] += 1.0;
+  fStats[1] += 1.0;
+  fStats[2] += x;
+  fStats[3] += x * x;
+  fStats[4] += y;
+  fStats[5] += y * y;
+  fStats[6] += x * y;
+}
+
+/**
+ * Fills have unit weights, so the sum of squared weights of a bin equals its content;
+ * statistics are added to the current ones, so the histogram may have been filled before
+ */
+void HistogramAccumulator::AddTo(TH1* histogram)
+{
+  if (fEntries == 0.0) return;
+  Double_t stats[TH1::kNstat];
+  for (int i = 0; i < TH1::kNstat; i++) stats[i] = 0.0;
+  histogram->GetStats(stats);
+  Double_t entries = histogram->GetEntries();
+  int nStats = histogram->GetDimension() > 1 ? 7 : 4;
+  for (int i = 0; i < nStats; i++) stats[i] += fStats[i];
+
+  bool hasSumw2 = histogram->GetSumw2N() > 0;
+  TArrayD* sumw2 = histogram->GetSumw2();
+  for (std::size_t bin = 0; bin < fContent.size(); bin++) {
+    if (fContent[bin] == 0.0) continue;
+    histogram->AddBinContent(bin, fContent[bin]);
+    if (hasSumw2) sumw2->fArray[bin] += fContent[bin];
+  }
+  histogram->PutStats(stats);
+  histogram->SetEntries(entries + fEntries);
+  Clear();
+}
+
+void HistogramAccumulator::Clear()
+{
+  std::fill(fContent.begin(), fContent.end(), 0.0);
+  fEntries = 0.0;
+  for (double& sum : fStats) sum = 0.0;
+}
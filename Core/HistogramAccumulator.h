@@ -0,0 +1,54 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file HistogramAccumulator.h
+ */
+
+#ifndef HISTOGRAMACCUMULATOR_H
+#define HISTOGRAMACCUMULATOR_H 1
+
+#include <TH1.h>
+#include <vector>
+
+/**
+ * @class HistogramAccumulator
+ * @brief plain bin array with the fixed binning of a TH1D or TH2D; filled without ROOT
+ * by a single thread and added to the histogram with its statistics at the end of the run
+ */
+class HistogramAccumulator
+{
+public:
+  explicit HistogramAccumulator(const TH1* histogram);
+  void Fill(double x);
+  void Fill(double x, double y);
+  //! Adds content, entries and sums of the statistics to the histogram and clears the accumulator
+  void AddTo(TH1* histogram);
+  void Clear();
+
+private:
+  struct Axis {
+    int fBins;
+    double fMin;
+    double fMax;
+    //! Same bin as TAxis::FindBin: 0 underflow, fBins + 1 overflow
+    int FindBin(double value) const;
+  };
+  Axis fX;
+  Axis fY;
+  //! Global bin numbering of ROOT, under- and overflow bins included
+  std::vector<double> fContent;
+  double fEntries = 0.0;
+  //! Sums as in TH1::GetStats: w, w^2, wx, wx^2, wy, wy^2, wxy
+  double fStats[7] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+};
+
+#endif /* !HISTOGRAMACCUMULATOR_H */
@@ -85,58 +85,91 @@ void MaterialExtension::SetpPsComponent(G4double lifetime, G4double fraction)
   }
 }
 
-G4double MaterialExtension::GetLifetime(double randNumber, DecayChannel channel) const
+void MaterialExtension::ChangeMaterialConstants()
 {
-  if (channel == DecayChannel::Ortho2G) {
-    return fMaterialParameters->GetoPs2GLifetimeFromVector(randNumber);
-  } else if (channel == DecayChannel::Ortho3G) {
-    return fMaterialParameters->GetoPs3GLifetimeFromVector(randNumber);
-  } else if (channel == DecayChannel::Para2G) {
-    return fMaterialParameters->GetpPsLifetime();
-  } else if (channel == DecayChannel::Direct) {
-    return fMaterialParameters->GetDirectLifetimeFromVector(randNumber);
-  } else {
-    G4Exception(
-      "MaterialExtension", "ME01", JustWarning,
-      "wrong decay channel for GetLifetime function"
-    );
-    return -1.0;
-  }
+  fMaterialParameters->SetMaterialByName(MaterialParameters::MaterialID::mUnknown);
+  BuildDecayTable();
 }
 
-void MaterialExtension::ChangeMaterialConstants()
+void MaterialExtension::FillIntensities()
 {
-  fMaterialParameters->SetMaterialByName(MaterialParameters::MaterialID::mUnknown);
+  fMaterialParameters->SetComponentsIntensities();
+  BuildDecayTable();
 }
 
-std::vector<G4double> MaterialExtension::GetEventsFraction() const
+void MaterialExtension::UpdateDecayTables()
 {
-  std::vector<G4double> frac;
-  if (MaterialParameters::fAnnihlationMode != "") {
-    if(MaterialParameters::fAnnihlationMode == "pPs3G") {
-      frac = {0.,0.,0.,0.,0.,1.};
-      return frac;
-    } else if (MaterialParameters::fAnnihlationMode == "oPs3G") {
-      frac = {0., 0., 0., 0., 1.};
-      return frac;
-    } else if (MaterialParameters::fAnnihlationMode == "oPs2G") {
-      frac = {0., 0., 1., 0., 0.};
-      return frac;
-    } else if (MaterialParameters::fAnnihlationMode == "pPs2G") {
-      frac = {1., 0., 0., 0., 0.};
-      return frac;
+  for (G4Material* material : *G4Material::GetMaterialTable()) {
+    MaterialExtension* extension = dynamic_cast<MaterialExtension*>(material);
+    if (extension) {
+      extension->BuildDecayTable();
     }
   }
+}
+
+/**
+ * Direct annihilation gives 3g with the fraction fDirect3Gfraction, o-Ps components decay
+ * to 2g by pick-off/conversion or to 3g. If no component has a positive intensity,
+ * the last lifetime of the mode is used, as the scan over the components did.
+ */
+void MaterialExtension::BuildDecayTable()
+{
+  fDecays.clear();
+  fDecayIntensities.clear();
+  const G4String& mode = MaterialParameters::fAnnihlationMode;
+  const std::vector<G4double>& oPsLifetimes = fMaterialParameters->GetoPsLifetimes();
+  const std::vector<G4double>& directLifetimes = fMaterialParameters->GetDirectLifetimes();
+  const std::vector<G4double>& oPs2GIntensities = fMaterialParameters->GetoPs2GIntensities();
+  const std::vector<G4double>& oPs3GIntensities = fMaterialParameters->GetoPs3GIntensities();
+  const std::vector<G4double>& directIntensities = fMaterialParameters->GetDirectIntensities();
+  G4double pPsLifetime = fMaterialParameters->GetpPsLifetime();
 
-  G4double pPs = fMaterialParameters->GetpPs2GTotalIntensity();
-  G4double direct2g = fMaterialParameters->GetDirect2GTotalIntensity();
-  G4double oPs2G = fMaterialParameters->GetoPs2GTotalIntensity();
-  G4double direct3g = fMaterialParameters->GetDirect3GTotalIntensity();
-  G4double oPs3G = fMaterialParameters->GetoPs3GTotalIntensity();
-  G4double pPs3G = 0; //fMaterialParameters->GetpPs3GTotalIntensity();
+  if (mode == "pPs2G") {
+    AddDecay(DecayChannel::Para2G, 2, pPsLifetime, 1.0);
+  } else if (mode == "pPs3G") {
+    AddDecay(DecayChannel::Para3G, 3, pPsLifetime, 1.0);
+  } else if (mode == "oPs2G" || mode == "oPs3G") {
+    G4bool threeGamma = (mode == "oPs3G");
+    for (unsigned i = 0; i < oPsLifetimes.size(); i++) {
+      AddDecay(
+        threeGamma ? DecayChannel::Ortho3G : DecayChannel::Ortho2G, threeGamma ? 3 : 2,
+        oPsLifetimes[i], threeGamma ? oPs3GIntensities[i] : oPs2GIntensities[i]
+      );
+    }
+    if (fDecays.empty()) {
+      AddDecay(
+        threeGamma ? DecayChannel::Ortho3G : DecayChannel::Ortho2G, threeGamma ? 3 : 2,
+        MaterialParameters::GetLifetimeVector(oPsLifetimes), 1.0
+      );
+    }
+  } else {
+    AddDecay(DecayChannel::Para2G, 2, pPsLifetime, fMaterialParameters->GetpPs2GTotalIntensity());
+    for (unsigned i = 0; i < directLifetimes.size(); i++) {
+      AddDecay(
+        DecayChannel::Direct, 2, directLifetimes[i],
+        directIntensities[i] * (1. - MaterialParameters::fDirect3Gfraction)
+      );
+      AddDecay(
+        DecayChannel::Direct, 3, directLifetimes[i],
+        directIntensities[i] * MaterialParameters::fDirect3Gfraction
+      );
+    }
+    for (unsigned i = 0; i < oPsLifetimes.size(); i++) {
+      AddDecay(DecayChannel::Ortho2G, 2, oPsLifetimes[i], oPs2GIntensities[i]);
+      AddDecay(DecayChannel::Ortho3G, 3, oPsLifetimes[i], oPs3GIntensities[i]);
+    }
+    if (fDecays.empty()) {
+      AddDecay(DecayChannel::Direct, 2, MaterialParameters::GetLifetimeVector(directLifetimes), 1.0);
+    }
+  }
+  fDecayTable.Build(fDecayIntensities);
+}
 
-  //! 2g direct // 2g pickoff // 3g direct // 3g oPs
-  frac = { pPs, direct2g, oPs2G, direct3g, oPs3G, pPs3G };
-  return frac;
+void MaterialExtension::AddDecay(
+  DecayChannel channel, G4int gammas, G4double lifetime, G4double intensity
+) {
+  if (intensity > 0.) {
+    fDecays.push_back({channel, gammas, lifetime});
+    fDecayIntensities.push_back(intensity);
+  }
 }
- 
@@ -18,6 +18,7 @@
 
 #include "../Info/MaterialExtensionMessenger.h"
 #include "MaterialParameters.h"
+#include "AliasTable.h"
 
 #include <G4VMaterialExtension.hh>
 #include <G4SystemOfUnits.hh>
@@ -37,6 +38,13 @@ public:
   enum DecayChannel { 
     Ortho2G, Ortho3G, Para2G, Direct, Para3G
   };
+
+  //! Decay channel with the number of emitted gammas and the mean lifetime of one component
+  struct DecayComponent {
+    DecayChannel fChannel;
+    G4int fGammas;
+    G4double fLifetime;
+  };
     
   MaterialExtension(
     MaterialParameters::MaterialID materialID, 
@@ -48,7 +56,6 @@ public:
   void AddoPsComponent(G4double lifetime, G4double probability);
   void AddDirectComponent(G4double lifetime, G4double probability);
   void SetpPsComponent(G4double lifetime, G4double fraction);
-  G4double GetLifetime(double randNumber, DecayChannel channel) const;
 
   /*
    * Changing lifetime and intensity parameters of Material to the parameters from
@@ -58,9 +65,13 @@ public:
    * is cleared in the meesenger for further modification of different material
   */
   void ChangeMaterialConstants();
-  void FillIntensities() { fMaterialParameters->SetComponentsIntensities(); };
-  //! 2g direct; 2g pickoff (lifetime 3g); 3g direct; 3g oPs (lifetime 3g)
-  std::vector<G4double> GetEventsFraction() const;
+  void FillIntensities();
+  //! Decay channel together with its lifetime component drawn from a single number in [0, 1)
+  const DecayComponent& SampleDecay(G4double randNumber) const {
+    return fDecays[fDecayTable.Sample(randNumber)];
+  };
+  //! Rebuilds the decay tables of all materials, called when the annihilation mode changes
+  static void UpdateDecayTables();
 
   G4bool IsTarget() const { return fTarget; };
   void AllowsAnnihilations(G4bool tf) { fTarget = tf; };
@@ -74,6 +85,13 @@ private:
     MaterialExtensionMessenger::GetMaterialExtensionMessenger();
   G4bool fTarget;
   MaterialParameters* fMaterialParameters = nullptr;
+
+  //! Components weighted by their intensities, restricted to the annihilation mode if it is set
+  void BuildDecayTable();
+  void AddDecay(DecayChannel channel, G4int gammas, G4double lifetime, G4double intensity);
+  std::vector<DecayComponent> fDecays;
+  std::vector<G4double> fDecayIntensities;
+  AliasTable fDecayTable;
 };
 
 #endif /* !MATERIALEXTENSION_H */
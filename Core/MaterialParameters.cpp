@@ -142,6 +142,7 @@ void MaterialParameters::SetMaterialByName(MaterialID materialID)
 void MaterialParameters::SetAnnihilationMode(G4String mode)
 {
   fAnnihlationMode = mode;
+  MaterialExtension::UpdateDecayTables();
 }
 
 void MaterialParameters::AddoPsComponent(G4double lifetime, G4double probability)
@@ -281,54 +282,6 @@ G4double MaterialParameters::GetoPsIntensity3G(G4double oPsLifetime, G4double oP
   return (oPsLifetime / foPsTauVaccum) * oPsProbability / 100.;
 }
 
-G4double MaterialParameters::GetoPs2GLifetimeFromVector(double randNumber)
-{
-  double randNumberNorm = randNumber;
-  if (fAnnihlationMode != "") {
-    randNumberNorm = randNumber * GetoPs2GTotalIntensity();
-  }
-  double intensitySum = 0.;
-  for (unsigned i = 0; i < foPsLifetimes.size(); i++) {
-    intensitySum += foPs2GIntensities[i];
-    if (randNumberNorm < intensitySum){
-      return foPsLifetimes[i];
-    }
-  }
-  return GetLifetimeVector(foPsLifetimes);
-}
-
-G4double MaterialParameters::GetoPs3GLifetimeFromVector(double randNumber)
-{
-  double randNumberNorm = randNumber;
-  if (fAnnihlationMode != "") {
-    randNumberNorm = randNumber * GetoPs3GTotalIntensity();
-  }
-  double intensitySum = 0.;
-  for (unsigned i = 0; i < foPsLifetimes.size(); i++) {
-    intensitySum += foPs3GIntensities[i];
-    if (randNumberNorm < intensitySum){
-      return foPsLifetimes[i];
-    }
-  }
-  return GetLifetimeVector(foPsLifetimes);
-}
-
-G4double MaterialParameters::GetDirectLifetimeFromVector(double randNumber)
-{
-  double randNumberNorm = randNumber;
-  if (fAnnihlationMode != ""){
-    randNumberNorm = randNumber * GetDirect2GTotalIntensity();
-  }
-  double intensitySum = 0.;
-  for (unsigned i = 0; i < fDirectLifetimes.size(); i++) {
-    intensitySum += fDirectIntensities[i];
-    if (randNumberNorm < intensitySum){
-      return fDirectLifetimes[i];
-    }
-  }
-  return GetLifetimeVector(fDirectLifetimes);
-}
-
 G4double MaterialParameters::GetpPsLifetime() const { return fpPsLifetime; }
 
 G4double MaterialParameters::GetLifetimeVector(std::vector<G4double> vectorToCheck)
@@ -77,10 +77,12 @@ public:
   G4double GetDirect2GTotalIntensity() const;
   G4double GetDirect3GTotalIntensity() const;
   G4double GetpPs2GTotalIntensity() const;
-  G4double GetoPs2GLifetimeFromVector(double randNumber);
-  G4double GetoPs3GLifetimeFromVector(double randNumber);
-  G4double GetDirectLifetimeFromVector(double randNumber);
   G4double GetpPsLifetime() const;
+  const std::vector<G4double>& GetoPsLifetimes() const { return foPsLifetimes; };
+  const std::vector<G4double>& GetoPs2GIntensities() const { return foPs2GIntensities; };
+  const std::vector<G4double>& GetoPs3GIntensities() const { return foPs3GIntensities; };
+  const std::vector<G4double>& GetDirectLifetimes() const { return fDirectLifetimes; };
+  const std::vector<G4double>& GetDirectIntensities() const { return fDirectIntensities; };
   static G4double GetLifetimeVector(std::vector<G4double> vectorToCheck);
 
   static const G4double foPsTauVaccum;
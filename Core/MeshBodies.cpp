@@ -0,0 +1,146 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file MeshBodies.cpp
+ */
+
+#include "MeshBodies.h"
+
+#include <G4TriangularFacet.hh>
+#include <G4SystemOfUnits.hh>
+#include <algorithm>
+#include <numeric>
+#include <array>
+#include <cmath>
+#include <map>
+
+namespace
+{
+  //! Vertices closer than this are the same vertex of the mesh
+  const G4double kVertexTolerance = 1.e-6 * mm;
+
+  struct Triangle {
+    G4ThreeVector fVertices[3];
+  };
+
+  struct UnionFind {
+    std::vector<G4int> fParent;
+    explicit UnionFind(std::size_t size) : fParent(size) { std::iota(fParent.begin(), fParent.end(), 0); }
+    G4int Find(G4int i)
+    {
+      while (fParent[i] != i) i = fParent[i] = fParent[fParent[i]];
+      return i;
+    }
+    void Join(G4int i, G4int j) { fParent[Find(i)] = Find(j); }
+  };
+
+  std::array<long long, 3> Key(const G4ThreeVector& v)
+  {
+    return {
+      std::llround(v.x() / kVertexTolerance), std::llround(v.y() / kVertexTolerance),
+      std::llround(v.z() / kVertexTolerance)
+    };
+  }
+
+  //! Groups of triangle indices, one group per value of the union-find root
+  std::vector<std::vector<G4int>> Groups(UnionFind& sets, const std::vector<std::vector<G4int>>& members)
+  {
+    std::map<G4int, std::vector<G4int>> groups;
+    for (std::size_t i = 0; i < members.size(); i++) {
+      auto& group = groups[sets.Find(i)];
+      group.insert(group.end(), members[i].begin(), members[i].end());
+    }
+    std::vector<std::vector<G4int>> result;
+    for (auto& group : groups) result.push_back(std::move(group.second));
+    return result;
+  }
+
+  G4TessellatedSolid* MakeSolid(
+    const G4String& name, const std::vector<Triangle>& triangles, const std::vector<G4int>& indices
+  ) {
+    G4TessellatedSolid* solid = new G4TessellatedSolid(name);
+    for (G4int i : indices) {
+      const Triangle& t = triangles[i];
+      solid->AddFacet(new G4TriangularFacet(t.fVertices[0], t.fVertices[1], t.fVertices[2], ABSOLUTE));
+    }
+    solid->SetSolidClosed(true);
+    return solid;
+  }
+}
+
+/**
+ * Triangles sharing a vertex belong to the same shell. A shell whose vertex lies inside another
+ * shell is a cavity or a body inside a cavity of that shell, together they are one body as in
+ * the original solid; the other shells do not overlap, so their union is the original solid.
+ */
+std::vector<G4TessellatedSolid*> MeshBodies::Split(G4TessellatedSolid* mesh, const G4String& name)
+{
+  std::vector<Triangle> triangles;
+  for (G4int i = 0; i < mesh->GetNumberOfFacets(); i++) {
+    G4VFacet* facet = mesh->GetFacet(i);
+    for (G4int first = 1; first + 1 < facet->GetNumberOfVertices(); first++) {
+      triangles.push_back({{facet->GetVertex(0), facet->GetVertex(first), facet->GetVertex(first + 1)}});
+    }
+  }
+
+  UnionFind connected(triangles.size());
+  std::map<std::array<long long, 3>, G4int> vertexTriangle;
+  for (std::size_t i = 0; i < triangles.size(); i++) {
+    for (const G4ThreeVector& vertex : triangles[i].fVertices) {
+      auto inserted = vertexTriangle.emplace(Key(vertex), i);
+      if (!inserted.second) connected.Join(i, inserted.first->second);
+    }
+  }
+  std::vector<std::vector<G4int>> single(triangles.size());
+  for (std::size_t i = 0; i < triangles.size(); i++) single[i] = {static_cast<G4int>(i)};
+  std::vector<std::vector<G4int>> shells = Groups(connected, single);
+  if (shells.size() < 2) return {mesh};
+
+  std::vector<G4TessellatedSolid*> shellSolids;
+  std::vector<G4ThreeVector> shellMin, shellMax;
+  for (std::size_t i = 0; i < shells.size(); i++) {
+    shellSolids.push_back(MakeSolid(name, triangles, shells[i]));
+    G4ThreeVector min, max;
+    shellSolids.back()->BoundingLimits(min, max);
+    shellMin.push_back(min);
+    shellMax.push_back(max);
+  }
+  UnionFind enclosed(shells.size());
+  for (std::size_t i = 0; i < shells.size(); i++) {
+    const G4ThreeVector& vertex = triangles[shells[i].front()].fVertices[0];
+    for (std::size_t j = 0; j < shells.size(); j++) {
+      if (i == j) continue;
+      G4bool inBox = shellMin[j].x() <= shellMin[i].x() && shellMin[j].y() <= shellMin[i].y()
+        && shellMin[j].z() <= shellMin[i].z() && shellMax[i].x() <= shellMax[j].x()
+        && shellMax[i].y() <= shellMax[j].y() && shellMax[i].z() <= shellMax[j].z();
+      if (inBox && shellSolids[j]->Inside(vertex) == kInside) enclosed.Join(i, j);
+    }
+  }
+
+  std::vector<G4TessellatedSolid*> bodies;
+  std::vector<std::vector<G4int>> shellIndices(shells.size());
+  for (std::size_t i = 0; i < shells.size(); i++) shellIndices[i] = {static_cast<G4int>(i)};
+  for (const std::vector<G4int>& body : Groups(enclosed, shellIndices)) {
+    if (body.size() == 1) {
+      bodies.push_back(shellSolids[body.front()]);
+      continue;
+    }
+    std::vector<G4int> bodyTriangles;
+    for (G4int shell : body) {
+      bodyTriangles.insert(bodyTriangles.end(), shells[shell].begin(), shells[shell].end());
+      delete shellSolids[shell];
+    }
+    bodies.push_back(MakeSolid(name, triangles, bodyTriangles));
+  }
+  delete mesh;
+  return bodies;
+}
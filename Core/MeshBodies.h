@@ -0,0 +1,35 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file MeshBodies.h
+ */
+
+#ifndef MESHBODIES_H
+#define MESHBODIES_H 1
+
+#include <G4TessellatedSolid.hh>
+#include <globals.hh>
+#include <vector>
+
+/**
+ * @class MeshBodies
+ * @brief splits a tessellated solid into its separate closed bodies; each body is a smaller
+ * solid with its own extent, so the mother volume rejects most of them by the bounding box
+ */
+class MeshBodies
+{
+public:
+  //! Mesh is deleted if it is split; shells enclosed in another shell (cavities) stay in the same solid
+  static std::vector<G4TessellatedSolid*> Split(G4TessellatedSolid* mesh, const G4String& name);
+};
+
+#endif /* !MESHBODIES_H */
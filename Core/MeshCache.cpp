@@ -0,0 +1,156 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file MeshCache.cpp
+ */
+
+#include "MeshCache.h"
+
+#include <G4TessellatedSolid.hh>
+#include <G4TriangularFacet.hh>
+#include <CADMesh.hh>
+#include <unistd.h>
+#include <iterator>
+#include <fstream>
+#include <cstring>
+#include <chrono>
+#include <cstdio>
+
+namespace
+{
+  //! Changed with the layout of the cache file
+  const char kMagic[8] = {'J', 'P', 'E', 'T', 'M', 'S', 'H', '1'};
+
+  //! FNV-1a, only used to detect changes of the STL file
+  std::uint64_t Hash(const char* data, std::size_t size, std::uint64_t hash = 14695981039346656037ULL)
+  {
+    for (std::size_t i = 0; i < size; i++) {
+      hash ^= static_cast<unsigned char>(data[i]);
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+}
+
+/**
+ * Hashing the file costs a single read, parsing by CADMesh is done only when the content
+ * or the scale changed; quadrangular facets are stored as two triangles. The solid parsed
+ * by CADMesh is used as it is, the cached one has the same triangles.
+ */
+G4VSolid* MeshCache::Load(const G4String& stlFile, G4double scale, const G4String& name)
+{
+  auto start = std::chrono::steady_clock::now();
+  std::uint64_t hash = 0;
+  std::vector<G4double> vertices;
+  G4bool cached = false;
+  G4String cacheFile;
+  if (fEnabled) {
+    std::ifstream stl(stlFile, std::ios::binary);
+    std::vector<char> content((std::istreambuf_iterator<char>(stl)), std::istreambuf_iterator<char>());
+    hash = Hash(content.data(), content.size());
+    hash = Hash(reinterpret_cast<const char*>(&scale), sizeof(scale), hash);
+    cacheFile = GetCacheFileName(stlFile, hash);
+    cached = Read(cacheFile, hash, vertices);
+  }
+
+  G4TessellatedSolid* solid = nullptr;
+  if (!cached) {
+    CADMesh mesh(const_cast<char*>(stlFile.c_str()));
+    mesh.SetScale(scale);
+    solid = dynamic_cast<G4TessellatedSolid*>(mesh.TessellatedMesh());
+    if (solid) solid->SetName(name);
+    if (fEnabled && solid) {
+      for (G4int i = 0; i < solid->GetNumberOfFacets(); i++) {
+        G4VFacet* facet = solid->GetFacet(i);
+        for (G4int first = 1; first + 1 < facet->GetNumberOfVertices(); first++) {
+          for (G4int vertex : {0, first, first + 1}) {
+            G4ThreeVector v = facet->GetVertex(vertex);
+            vertices.insert(vertices.end(), {v.x(), v.y(), v.z()});
+          }
+        }
+      }
+      Write(cacheFile, hash, vertices);
+    }
+  } else {
+    solid = new G4TessellatedSolid(name);
+    for (std::size_t i = 0; i < vertices.size(); i += 9) {
+      solid->AddFacet(new G4TriangularFacet(
+        G4ThreeVector(vertices[i], vertices[i + 1], vertices[i + 2]),
+        G4ThreeVector(vertices[i + 3], vertices[i + 4], vertices[i + 5]),
+        G4ThreeVector(vertices[i + 6], vertices[i + 7], vertices[i + 8]),
+        ABSOLUTE
+      ));
+    }
+    solid->SetSolidClosed(true);
+  }
+  if (!solid) return nullptr;
+  G4cout << "----> Mesh " << stlFile << ": " << solid->GetNumberOfFacets() << " facets "
+    << (cached ? "read from " + cacheFile : G4String("parsed")) << " in "
+    << 1.e3 * std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " ms" << G4endl;
+  return solid;
+}
+
+G4String MeshCache::GetCacheFileName(const G4String& stlFile, std::uint64_t hash) const
+{
+  std::size_t slash = stlFile.rfind('/');
+  G4String directory = fDirectory;
+  if (directory.empty()) {
+    directory = slash == std::string::npos ? "." : stlFile.substr(0, slash);
+  }
+  G4String baseName = slash == std::string::npos ? stlFile : stlFile.substr(slash + 1);
+  char hashText[17];
+  std::snprintf(hashText, sizeof(hashText), "%016llx", static_cast<unsigned long long>(hash));
+  return directory + "/" + baseName + "." + hashText + ".mesh";
+}
+
+G4bool MeshCache::Read(const G4String& cacheFile, std::uint64_t hash, std::vector<G4double>& vertices) const
+{
+  std::ifstream file(cacheFile, std::ios::binary);
+  if (!file) return false;
+  char magic[sizeof(kMagic)];
+  std::uint64_t storedHash = 0;
+  std::uint64_t nFacets = 0;
+  file.read(magic, sizeof(magic));
+  file.read(reinterpret_cast<char*>(&storedHash), sizeof(storedHash));
+  file.read(reinterpret_cast<char*>(&nFacets), sizeof(nFacets));
+  if (!file || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || storedHash != hash) return false;
+  //! Facet count of a corrupt file must not be trusted - it has to match the size of the rest of the file
+  std::streampos begin = file.tellg();
+  file.seekg(0, std::ios::end);
+  std::uint64_t remaining = static_cast<std::uint64_t>(file.tellg() - begin);
+  file.seekg(begin);
+  if (!file || remaining % (9 * sizeof(G4double)) != 0 || nFacets != remaining / (9 * sizeof(G4double))) return false;
+  vertices.resize(9 * nFacets);
+  file.read(reinterpret_cast<char*>(vertices.data()), vertices.size() * sizeof(G4double));
+  if (!file) {
+    vertices.clear();
+    return false;
+  }
+  return true;
+}
+
+//! Written to a temporary file and renamed, so jobs started at the same time never read a partial file
+void MeshCache::Write(const G4String& cacheFile, std::uint64_t hash, const std::vector<G4double>& vertices) const
+{
+  G4String tmpFile = cacheFile + ".tmp" + std::to_string(::getpid());
+  std::ofstream file(tmpFile, std::ios::binary);
+  std::uint64_t nFacets = vertices.size() / 9;
+  file.write(kMagic, sizeof(kMagic));
+  file.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+  file.write(reinterpret_cast<const char*>(&nFacets), sizeof(nFacets));
+  file.write(reinterpret_cast<const char*>(vertices.data()), vertices.size() * sizeof(G4double));
+  file.close();
+  if (!file || std::rename(tmpFile.c_str(), cacheFile.c_str()) != 0) {
+    std::remove(tmpFile.c_str());
+    G4Exception("MeshCache", "MC01", JustWarning, ("Can not write the mesh cache " + cacheFile).c_str());
+  }
+}
@@ -0,0 +1,50 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file MeshCache.h
+ */
+
+#ifndef MESHCACHE_H
+#define MESHCACHE_H 1
+
+#include <G4VSolid.hh>
+#include <globals.hh>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class MeshCache
+ * @brief tessellated solids of the CAD files; facets parsed by CADMesh are stored in a binary
+ * file keyed by the hash of the STL content and the scale, later constructions read them directly
+ */
+class MeshCache
+{
+public:
+  MeshCache() {}
+  //! Switched off - every construction parses the STL file
+  void SetEnabled(G4bool tf) { fEnabled = tf; };
+  //! Directory of the cache files, by default the directory of the STL file
+  void SetDirectory(const G4String& directory) { fDirectory = directory; };
+  //! Tessellated solid of the STL file with lengths multiplied by the scale
+  G4VSolid* Load(const G4String& stlFile, G4double scale, const G4String& name);
+
+private:
+  G4String GetCacheFileName(const G4String& stlFile, std::uint64_t hash) const;
+  //! Vertices of the triangles, 9 coordinates per facet; false if there is no valid cache file
+  G4bool Read(const G4String& cacheFile, std::uint64_t hash, std::vector<G4double>& vertices) const;
+  void Write(const G4String& cacheFile, std::uint64_t hash, const std::vector<G4double>& vertices) const;
+
+  G4bool fEnabled = true;
+  G4String fDirectory = "";
+};
+
+#endif /* !MESHCACHE_H */
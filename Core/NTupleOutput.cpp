@@ -0,0 +1,40 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file NTupleOutput.cpp
+ */
+
+#ifdef JPETMC_WITH_RNTUPLE
+
+#include "NTupleOutput.h"
+
+NTupleOutput::NTupleOutput(TFile& file, int compression, bool storePolarization, bool storeMomentum)
+{
+  auto model = RNTupleAPI::RNTupleModel::Create();
+  fColumns.Create(*model, storePolarization, storeMomentum);
+  RNTupleAPI::RNTupleWriteOptions options;
+  if (compression >= 0) options.SetCompression(compression);
+  fWriter = RNTupleAPI::RNTupleWriter::Append(std::move(model), "T", file, options);
+}
+
+void NTupleOutput::Fill(JPetGeantEventPack& pack)
+{
+  fColumns.FromEventPack(pack);
+  fWriter->Fill();
+}
+
+void NTupleOutput::Close()
+{
+  fWriter.reset();
+}
+
+#endif /* JPETMC_WITH_RNTUPLE */
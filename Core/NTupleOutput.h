@@ -0,0 +1,44 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file NTupleOutput.h
+ */
+
+#ifndef NTUPLEOUTPUT_H
+#define NTUPLEOUTPUT_H 1
+
+#include "../Objects/Framework/JPetGeantEventPack.h"
+#include "../Objects/Framework/JPetGeantNTuple.h"
+#include <ROOT/RNTupleWriter.hxx>
+#include <TFile.h>
+#include <memory>
+
+/**
+ * @class NTupleOutput
+ * @brief writes events as RNTuple "T" into the output file, alternative to the TTree output
+ */
+class NTupleOutput
+{
+public:
+  //! compression: ROOT compression settings, -1 for the RNTuple default;
+  //! switched off hit groups are not written at all
+  NTupleOutput(TFile& file, int compression, bool storePolarization, bool storeMomentum);
+  void Fill(JPetGeantEventPack& pack);
+  //! Writes remaining clusters and metadata, the file has to be still open
+  void Close();
+
+private:
+  std::unique_ptr<RNTupleAPI::RNTupleWriter> fWriter;
+  JPetGeantNTupleColumns fColumns;
+};
+
+#endif /* !NTUPLEOUTPUT_H */
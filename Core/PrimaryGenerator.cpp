@@ -19,18 +19,43 @@
 #include "MaterialParameters.h"
 #include "DetectorConstants.h"
 #include "MaterialExtension.h"
+#include "ThreeGammaSampler.h"
 #include "PrimaryGenerator.h"
+#include "EventSeeder.h"
 
 #include <G4HadPhaseSpaceGenbod.hh>
 #include <G4ParticleDefinition.hh>
 #include <G4PhysicalConstants.hh>
 #include <G4RandomDirection.hh>
 #include <G4SystemOfUnits.hh>
-#include <G4ParticleTable.hh>
+#include <G4AutoLock.hh>
 #include <Randomize.hh>
+#include <G4Gamma.hh>
 #include <globals.hh>
+#include <TRandom.h>
+#include <chrono>
+#include <cmath>
 
-PrimaryGenerator::PrimaryGenerator() : G4VPrimaryGenerator() {}
+namespace
+{
+  //! TGenPhaseSpace draws from gRandom, which is shared by all worker threads
+  G4Mutex phaseSpaceMutex = G4MUTEX_INITIALIZER;
+  //! Volumes crossed by the ray from the chamber center before the vertex search gives up
+  const G4int kMaxCrossedVolumes = 10000;
+}
+
+PrimaryGenerator::PrimaryGenerator() : G4VPrimaryGenerator(), fGamma(G4Gamma::Definition())
+{
+  Double_t mass_secondaries[3] = {0., 0., 0.};
+  TLorentzVector positonium(0.0, 0.0, 0.0, 1022 * keV);
+  if (!fTwoGammaPhaseSpace.SetDecay(positonium, 2, mass_secondaries)
+  || !fThreeGammaPhaseSpace.SetDecay(positonium, 3, mass_secondaries)) {
+    G4Exception(
+      "PrimaryGenerator", "PG09", FatalException,
+      "Decay of positronium into gammas is kinematically forbidden"
+    );
+  }
+}
 
 PrimaryGenerator::~PrimaryGenerator() {}
 
@@ -50,16 +75,46 @@ G4PrimaryVertex* PrimaryGenerator::GenerateThreeGammaVertex(
   vertex->SetT0(T0 + lifetime);
   vertex->SetPosition(vtxPosition.x(), vtxPosition.y(), vtxPosition.z());
 
-  G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
-  G4ParticleDefinition* particleDefinition = particleTable->FindParticle("gamma");
-  Double_t mass_secondaries[3] = {0., 0., 0.};
+  auto start = std::chrono::steady_clock::now();
+  G4ThreeVector momenta[3];
+  if (fUseThreeGammaTable) {
+    ThreeGammaSampler::GetSampler(channel).Sample(momenta);
+  } else {
+    GenerateThreeGammaMomentaWithPhaseSpace(channel, momenta);
+  }
+  G4double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  fThreeGammaTime += time;
+  fThreeGammaVertices++;
+  fMetrics->AddTime(fThreeGammaMomentaTime, time);
+  fMetrics->Add(fThreeGammaVertexCount);
 
-  TGenPhaseSpace event;
-  TLorentzVector positonium(0.0, 0.0, 0.0, 1022 * keV);
-  Bool_t test = event.SetDecay(positonium, 3, mass_secondaries);
-  if (!test) {
-    G4cout << "error: generate_gamma : createThreeEvts:" << test << G4endl;
+  G4PrimaryParticle* particle[3];
+  for (int i = 0; i < 3; i++) {
+    particle[i] = new G4PrimaryParticle(
+      fGamma, momenta[i].x(), momenta[i].y(), momenta[i].z(), momenta[i].mag()
+    );
+    PrimaryParticleInformation* infoParticle = new PrimaryParticleInformation();
+    infoParticle->SetGammaMultiplicity(PrimaryParticleInformation::koPsGamma);
+    infoParticle->SetGeneratedGammaMultiplicity(PrimaryParticleInformation::koPsGamma);
+    infoParticle->SetIndex(i + 1);
+    infoParticle->SetGenMomentum(momenta[i].x(), momenta[i].y(), momenta[i].z());
+    particle[i]->SetUserInformation(infoParticle);
+    vertex->SetPrimary(particle[i]);
   }
+  return vertex;
+}
+
+/**
+ * Accept/reject of TGenPhaseSpace events with the matrix element, kept for comparison
+ * with the tabulated sampler (/jpetmc/source/threeGammaSampler phaseSpace)
+ */
+void PrimaryGenerator::GenerateThreeGammaMomentaWithPhaseSpace(
+  const MaterialExtension::DecayChannel channel, G4ThreeVector momenta[3]
+) {
+  G4AutoLock lock(&phaseSpaceMutex);
+  //! gRandom continues the stream of the current event, independently of other threads
+  gRandom->SetSeed(EventSeeder::DrawROOTSeed());
+  TGenPhaseSpace& event = fThreeGammaPhaseSpace;
 
   Double_t weight = 1;
   Double_t weight_max = event.GetWtMax() * pow(10, -1);
@@ -75,27 +130,43 @@ G4PrimaryVertex* PrimaryGenerator::GenerateThreeGammaVertex(
     weight = weight * calculate_mQED( channel, 511., event.GetDecay(0)->E() / keV, event.GetDecay(1)->E() / keV, event.GetDecay(2)->E() / keV );
     rwt = M_max * weight_max * (G4UniformRand());
   } while (rwt > weight);
+  lock.unlock();
 
-  G4PrimaryParticle* particle[3];
   for (int i = 0; i < 3; i++) {
     TLorentzVector* out = event.GetDecay(i);
-    particle[i] = new G4PrimaryParticle(
-      particleDefinition, out->Px(), out->Py(), out->Pz(), out->E()
-    );
-    PrimaryParticleInformation* infoParticle = new PrimaryParticleInformation();
-    infoParticle->SetGammaMultiplicity(PrimaryParticleInformation::koPsGamma);
-    infoParticle->SetGeneratedGammaMultiplicity(PrimaryParticleInformation::koPsGamma);
-    infoParticle->SetIndex(i + 1);
-    infoParticle->SetGenMomentum(out->Px(), out->Py(), out->Pz());
-    particle[i]->SetUserInformation(infoParticle);
-    vertex->SetPrimary(particle[i]);
+    momenta[i].set(out->Px(), out->Py(), out->Pz());
   }
-  return vertex;
+}
+
+void PrimaryGenerator::PrintStatistics() const
+{
+  if (fThreeGammaVertices > 0) {
+    G4cout << "\n----> 3g vertices: " << fThreeGammaVertices << " generated with the "
+      << (fUseThreeGammaTable ? "tabulated" : "phase space") << " sampler in " << fThreeGammaTime << " s";
+    if (fThreeGammaTime > 0.0) {
+      G4cout << " (" << fThreeGammaVertices / fThreeGammaTime << " vertices/s)";
+    }
+    G4cout << G4endl;
+  }
+  if (fVertexSearches > 0) {
+    G4cout << "\n----> Vertex search: " << fVertexSearches << " vertices found with the "
+      << (fBoundaryVertexSearch ? "boundary traversal" : "fixed step walk") << ", "
+      << G4double(fVertexSearchLocates) / fVertexSearches << " navigator locates per vertex" << G4endl;
+  }
+}
+
+void PrimaryGenerator::ResetStatistics()
+{
+  fThreeGammaVertices = 0;
+  fThreeGammaTime = 0.0;
+  fVertexSearches = 0;
+  fVertexSearchLocates = 0;
 }
 
 G4PrimaryVertex* PrimaryGenerator::GenerateTwoGammaVertex(
   const G4ThreeVector vtxPosition, const G4double T0, const G4double lifetime2g
 ) {
+  fMetrics->Add(fTwoGammaVertexCount);
   G4PrimaryVertex* vertex = new G4PrimaryVertex();
   VtxInformation* info = new VtxInformation();
 
@@ -107,25 +178,18 @@ G4PrimaryVertex* PrimaryGenerator::GenerateTwoGammaVertex(
   vertex->SetT0(T0 + lifetime);
   vertex->SetPosition(vtxPosition.x(), vtxPosition.y(), vtxPosition.z());
 
-  G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
-  G4ParticleDefinition* particleDefinition = particleTable->FindParticle("gamma");
-
-  Double_t mass_secondaries[2] = {0., 0.};
-
-  TGenPhaseSpace event;
-  TLorentzVector positonium(0.0, 0.0, 0.0, 1022 * keV);
-  Bool_t test = event.SetDecay(positonium, 2, mass_secondaries);
-  if (!test) {
-    G4cout << "Error: generate_gamma : createTwoEvts" << test << G4endl;
-  }
-
+  G4AutoLock lock(&phaseSpaceMutex);
+  //! gRandom continues the stream of the current event, independently of other threads
+  gRandom->SetSeed(EventSeeder::DrawROOTSeed());
+  TGenPhaseSpace& event = fTwoGammaPhaseSpace;
   event.Generate();
+  lock.unlock();
   G4PrimaryParticle* particle[2];
 
   for (int i = 0; i < 2; i++) {
     TLorentzVector* out = event.GetDecay(i);
     particle[i] = new G4PrimaryParticle(
-      particleDefinition, out->Px(), out->Py(), out->Pz(), out->E()
+      fGamma, out->Px(), out->Py(), out->Pz(), out->E()
     );
 
     PrimaryParticleInformation* infoParticle = new PrimaryParticleInformation();
@@ -152,6 +216,7 @@ G4PrimaryVertex* PrimaryGenerator::GeneratePromptGammaVertex(
   const G4ThreeVector vtxPosition, const G4double T0,
   const G4double lifetimePrompt, const G4double energy
 ) {
+  fMetrics->Add(fPromptVertexCount);
   G4PrimaryVertex* vertex = new G4PrimaryVertex();
   VtxInformation* info = new VtxInformation();
 
@@ -163,11 +228,9 @@ G4PrimaryVertex* PrimaryGenerator::GeneratePromptGammaVertex(
   vertex->SetT0(T0 + lifetime);
   vertex->SetPosition(vtxPosition.x(), vtxPosition.y(), vtxPosition.z());
 
-  G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
-  G4ParticleDefinition* particleDefinition = particleTable->FindParticle("gamma");
   G4ThreeVector momentum = GetRandomPointOnSphere(energy);
   G4PrimaryParticle* particle1 = new G4PrimaryParticle(
-    particleDefinition, momentum.x(), momentum.y(), momentum.z(), energy
+    fGamma, momentum.x(), momentum.y(), momentum.z(), energy
   );
   PrimaryParticleInformation* infoParticle = new PrimaryParticleInformation();
   infoParticle->SetGammaMultiplicity(PrimaryParticleInformation::kPromptGamma);
@@ -179,6 +242,17 @@ G4PrimaryVertex* PrimaryGenerator::GeneratePromptGammaVertex(
   return vertex;
 }
 
+void PrimaryGenerator::GenerateAnnihilationVertex(
+  G4Event* event, const MaterialExtension* material, const G4ThreeVector vtxPosition, const G4double T0
+) {
+  const MaterialExtension::DecayComponent& decay = material->SampleDecay(G4UniformRand());
+  if (decay.fGammas == 2) {
+    event->AddPrimaryVertex(GenerateTwoGammaVertex(vtxPosition, T0, decay.fLifetime));
+  } else {
+    event->AddPrimaryVertex(GenerateThreeGammaVertex(decay.fChannel, vtxPosition, T0, decay.fLifetime));
+  }
+}
+
 void PrimaryGenerator::GenerateEvtSmallChamber(
   G4Event* event, const G4double effectivePositronRadius
 ) {
@@ -188,50 +262,11 @@ void PrimaryGenerator::GenerateEvtSmallChamber(
   std::tie(vtxPosition, material) = GetVerticesDistributionInFilledSphere(
     chamberCenter, effectivePositronRadius
   );
-  std::vector<G4double> evtFractions = material->GetEventsFraction();
-  G4double random = G4UniformRand();
-
   //! for sodium: emitted positrons have up to 100~keV velocity
   //! therefore their speed v=sqrt(2*e/m) = 0.6c
   G4double T0 = (vtxPosition - chamberCenter).mag() / (0.6 * c_light);
 
-  if (evtFractions[0] > random) {
-  // pPs
-    event->AddPrimaryVertex(GenerateTwoGammaVertex(
-      vtxPosition, T0,
-      material->GetLifetime(random, MaterialExtension::DecayChannel::Para2G)
-    ));
-  } else if (evtFractions[0] + evtFractions[1] > random) {
-  // Direct 2G
-    event->AddPrimaryVertex(GenerateTwoGammaVertex(
-      vtxPosition, T0,
-      material->GetLifetime(random - evtFractions[0], MaterialExtension::DecayChannel::Direct)
-    ));   
-  } else if (evtFractions[0] + evtFractions[1] + evtFractions[2] > random) {
-  // oPs 2G
-    event->AddPrimaryVertex(GenerateTwoGammaVertex(
-      vtxPosition, T0,
-      material->GetLifetime(random - evtFractions[0] - evtFractions[1], MaterialExtension::DecayChannel::Ortho2G)
-    ));    
-  } else if (evtFractions[0] + evtFractions[1] + evtFractions[2] + evtFractions[3] > random) {
-  // Direct 3G
-    event->AddPrimaryVertex(GenerateThreeGammaVertex(
-      MaterialExtension::DecayChannel::Direct, vtxPosition, T0,
-      material->GetLifetime(random - evtFractions[0] - evtFractions[1] - evtFractions[2], MaterialExtension::DecayChannel::Direct)
-    ));
-  } else if (evtFractions[0] + evtFractions[1] + evtFractions[2] + evtFractions[3] + evtFractions[4] > random) {
-  // oPs 3G
-    event->AddPrimaryVertex(GenerateThreeGammaVertex(
-      MaterialExtension::DecayChannel::Ortho3G, vtxPosition, T0,
-      material->GetLifetime(random - evtFractions[0] - evtFractions[1] - evtFractions[2] - evtFractions[3], MaterialExtension::DecayChannel::Ortho3G)
-    ));
-  } else {
-  // pPs 3G
-    event->AddPrimaryVertex(GenerateThreeGammaVertex(
-      MaterialExtension::DecayChannel::Para3G, vtxPosition, T0,
-      material->GetLifetime(random - evtFractions[0] - evtFractions[1] - evtFractions[2] - evtFractions[3]- evtFractions[4], MaterialExtension::DecayChannel::Para3G)
-    ));
-  } 
+  GenerateAnnihilationVertex(event, material, vtxPosition, T0);
 
   //! Add prompt gamma from sodium
   G4ThreeVector promptVtxPosition = VertexUniformInCylinder(0.2 * cm, 0.2 * cm) + chamberCenter;
@@ -249,28 +284,70 @@ std::tuple<G4ThreeVector, MaterialExtension*>
 PrimaryGenerator::GetVerticesDistributionInFilledSphere(
   const G4ThreeVector center, G4double radius
 ) {
-  G4bool vertexFound = false;
-  G4ThreeVector vertex(0 * cm, 0 * cm, 0 * cm);
-  MaterialExtension* material;
-
   //! annihilation will occure only in materials where it was allowed
   //! @see MaterialExtension
   //! annihilation rate 2g/3g also depends on the material type
-  while (!vertexFound) {
-    vertex = GetRandomPointInFilledSphere(radius) + center;
-    theNavigator = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-    material = dynamic_cast<MaterialExtension*>(
-      theNavigator->LocateGlobalPointAndSetup(vertex)->GetLogicalVolume()->GetMaterial()
-    );
-    vertexFound = material->IsTarget();
-  };
-  return std::make_tuple(vertex, material);
+  fTargetMap.Update(center, radius);
+  theNavigator = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+  return fTargetMap.Sample(theNavigator);
 }
 
+/**
+ * Instead of locating every point of the walk, the ray is traversed from boundary to boundary
+ * and only the volumes it crosses are located; in a target volume the first point of the walk
+ * before its exit is returned, so the vertex is the same as of the fixed step walk.
+ */
 std::tuple<G4ThreeVector, MaterialExtension*>
 PrimaryGenerator::GetVerticesDistributionAlongStepVector(
-  const G4ThreeVector center, const G4ThreeVector direction
+  const G4ThreeVector center, const G4ThreeVector step
 ) {
+  if (!fBoundaryVertexSearch) {
+    return GetVerticesDistributionWithFixedStep(center, step);
+  }
+  fVertexSearches++;
+  fMetrics->Add(fVertexSearchCount);
+  G4double stepLength = step.mag();
+  G4ThreeVector direction = step.unit();
+  fRayNavigator.SetWorldVolume(
+    G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume()
+  );
+
+  G4double distance = 0.0;
+  G4VPhysicalVolume* volume = fRayNavigator.LocateGlobalPointAndSetup(center, &direction, false, false);
+  fVertexSearchLocates++;
+  fMetrics->Add(fVertexSearchLocateCount);
+  //! Volume crossed again at the same point is skipped by the navigator, the limit only guards against loops
+  for (G4int i = 0; volume && i < kMaxCrossedVolumes; i++) {
+    G4ThreeVector point = center + distance * direction;
+    G4double safety = 0.0;
+    G4double distanceToBoundary = fRayNavigator.ComputeStep(point, direction, kInfinity, safety);
+    MaterialExtension* material = dynamic_cast<MaterialExtension*>(volume->GetLogicalVolume()->GetMaterial());
+    if (material && material->IsTarget()) {
+      G4double n = std::ceil(distance / stepLength);
+      if (n * stepLength < distance + distanceToBoundary) {
+        return std::make_tuple(center + n * step, material);
+      }
+    }
+    distance += distanceToBoundary;
+    fRayNavigator.SetGeometricallyLimitedStep();
+    volume = fRayNavigator.LocateGlobalPointAndSetup(center + distance * direction, &direction, true);
+    fVertexSearchLocates++;
+    fMetrics->Add(fVertexSearchLocateCount);
+  }
+  G4Exception(
+    "PrimaryGenerator", "PG08", FatalException,
+    "Ray from the chamber center leaves the world without reaching a target material"
+  );
+  return std::make_tuple(center, nullptr);
+}
+
+//! Walk used before the boundary traversal, kept for comparison (/jpetmc/run/vertexSearch fixedStep)
+std::tuple<G4ThreeVector, MaterialExtension*>
+PrimaryGenerator::GetVerticesDistributionWithFixedStep(
+  const G4ThreeVector center, const G4ThreeVector step
+) {
+  fVertexSearches++;
+  fMetrics->Add(fVertexSearchCount);
   G4bool lookForVtx = false;
   G4ThreeVector myPoint;
   G4ThreeVector myNextPoint = center;
@@ -281,11 +358,14 @@ PrimaryGenerator::GetVerticesDistributionAlongStepVector(
     mat = dynamic_cast<MaterialExtension*>(
       theNavigator->LocateGlobalPointAndSetup(myPoint)->GetLogicalVolume()->GetMaterial()
     );
+    fVertexSearchLocates++;
+    fMetrics->Add(fVertexSearchLocateCount);
     lookForVtx = mat->IsTarget();
-    myNextPoint = myPoint + direction;
+    myNextPoint = myPoint + step;
   };
   return std::make_tuple(myPoint, mat);
 }
+
 void PrimaryGenerator::GenerateEvtLargeChamber(G4Event* event)
 {
   G4ThreeVector chamberCenter = DetectorConstants::GetChamberCenter();
@@ -294,50 +374,11 @@ void PrimaryGenerator::GenerateEvtLargeChamber(G4Event* event)
   std::tie(vtxPosition, material) = GetVerticesDistributionAlongStepVector(
     chamberCenter, GetRandomPointInFilledSphere(1.0f * mm)
   );
-  std::vector<G4double> evtFractions = material->GetEventsFraction();
-  G4double random = G4UniformRand();
-
   //! for sodium: emitted positrons have up to 100~keV velocity
   //! therefore their speed v=sqrt(2*e/m) = 0.6c
   G4double T0 = (vtxPosition - chamberCenter).mag() / (0.6 * c_light);
 
-  if (evtFractions[0] > random) {
-  // pPs
-    event->AddPrimaryVertex(GenerateTwoGammaVertex(
-      vtxPosition, T0,
-      material->GetLifetime(random, MaterialExtension::DecayChannel::Para2G)
-    ));
-  } else if (evtFractions[0] + evtFractions[1] > random) {
-  // Direct 2G
-    event->AddPrimaryVertex(GenerateTwoGammaVertex(
-      vtxPosition, T0,
-      material->GetLifetime(random - evtFractions[0], MaterialExtension::DecayChannel::Direct)
-    ));   
-  } else if (evtFractions[0] + evtFractions[1] + evtFractions[2] > random) {
-  // oPs 2G
-    event->AddPrimaryVertex(GenerateTwoGammaVertex(
-      vtxPosition, T0,
-      material->GetLifetime(random - evtFractions[0] - evtFractions[1], MaterialExtension::DecayChannel::Ortho2G)
-    ));    
-  } else if (evtFractions[0] + evtFractions[1] + evtFractions[2] + evtFractions[3] > random) {
-  // Direct 3G
-    event->AddPrimaryVertex(GenerateThreeGammaVertex(
-      MaterialExtension::DecayChannel::Direct, vtxPosition, T0,
-      material->GetLifetime(random - evtFractions[0] - evtFractions[1] - evtFractions[2], MaterialExtension::DecayChannel::Direct)
-    ));
-  } else if (evtFractions[0] + evtFractions[1] + evtFractions[2] + evtFractions[3] + evtFractions[4] > random) {
-  // oPs 3G
-    event->AddPrimaryVertex(GenerateThreeGammaVertex(
-      MaterialExtension::DecayChannel::Ortho3G, vtxPosition, T0,
-      material->GetLifetime(random - evtFractions[0] - evtFractions[1] - evtFractions[2] - evtFractions[3], MaterialExtension::DecayChannel::Ortho3G)
-    ));
-  } else {
-  // pPs 3G
-    event->AddPrimaryVertex(GenerateThreeGammaVertex(
-      MaterialExtension::DecayChannel::Para3G, vtxPosition, T0,
-      material->GetLifetime(random - evtFractions[0] - evtFractions[1] - evtFractions[2] - evtFractions[3]- evtFractions[4], MaterialExtension::DecayChannel::Para3G)
-    ));
-  }
+  GenerateAnnihilationVertex(event, material, vtxPosition, T0);
 
   //! Add prompt gamma from sodium
   G4ThreeVector promptVtxPosition = VertexUniformInCylinder(0.2 * cm, 0.2 * cm) + chamberCenter;
@@ -351,14 +392,12 @@ void PrimaryGenerator::GenerateBeam(BeamParams* beamParams, G4Event* event)
 {
   G4ThreeVector vtxCoor = beamParams->GetVtx();
   G4PrimaryVertex* vertex = new G4PrimaryVertex(vtxCoor, 0);
-  G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
-  G4ParticleDefinition* particleDefinition = particleTable->FindParticle("gamma");
   const G4double ene = beamParams->GetEnergy();
   G4ThreeVector momentum = beamParams->GetMomentum();
   G4double px = ene * momentum.x();
   G4double py = ene * momentum.y();
   G4double pz = ene * momentum.z();
-  G4PrimaryParticle* particle1 = new G4PrimaryParticle(particleDefinition, px, py, pz, ene);
+  G4PrimaryParticle* particle1 = new G4PrimaryParticle(fGamma, px, py, pz, ene);
   PrimaryParticleInformation* infoParticle = new PrimaryParticleInformation();
   infoParticle->SetGammaMultiplicity(PrimaryParticleInformation::kPromptGamma);
   infoParticle->SetGeneratedGammaMultiplicity(PrimaryParticleInformation::kPromptGamma);
@@ -486,13 +525,5 @@ const G4ThreeVector PrimaryGenerator::GetRandomPointOnSphere(G4double radius)
 
 G4double PrimaryGenerator::calculate_mQED(const MaterialExtension::DecayChannel channel, Double_t mass_e, Double_t w1, Double_t w2, Double_t w3)
 {
-  if(channel == MaterialExtension::DecayChannel::Ortho3G or channel == MaterialExtension::DecayChannel::Direct) {
-    return pow((mass_e - w1) / (w2 * w3), 2) + pow((mass_e - w2) / (w1 * w3), 2) + pow((mass_e - w3) / (w1 * w2), 2);
-  } else if (channel == MaterialExtension::DecayChannel::Para3G) {
-    return pow(w1*w2*w3,2)* pow(sin(acos((-pow(w1,2) - pow(w2,2) + pow(w3,2))/(2*w1*w2))) +
-				       sin(acos(( pow(w1,2) - pow(w2,2) - pow(w3,2))/(2*w3*w2))) +
-				       sin(acos((-pow(w1,2) + pow(w2,2) - pow(w3,2))/(2*w1*w3))), 2)* 
-				       (pow(mass_e-w3,2)*pow(w1-w2,2) + pow(mass_e-w1,2)*pow(w2-w3,2) + pow(mass_e-w2,2)*pow(w3-w1,2));
-  }
-  return 0;
+  return ThreeGammaSampler::MatrixElement(channel, mass_e, w1, w2, w3);
 }
@@ -17,7 +17,9 @@
 #define PRIMARYGENERATOR_H 1
 
 #include "MaterialExtension.h"
+#include "TargetVoxelMap.h"
 #include "SourceParams.h"
+#include "RunMetrics.h"
 #include "BeamParams.h"
 
 #include <G4TransportationManager.hh>
@@ -39,6 +41,13 @@ public:
   void GenerateEvtSmallChamber(G4Event* event, const G4double);
   void GenerateEvtLargeChamber(G4Event* event);
   virtual void GeneratePrimaryVertex(G4Event*){};
+  //! Tabulated sampler of 3g energies (default) or TGenPhaseSpace with accept/reject
+  void SetThreeGammaTable(G4bool tf) { fUseThreeGammaTable = tf; };
+  //! Boundary to boundary traversal of the ray (default) or locating the points of the fixed step walk
+  void SetBoundaryVertexSearch(G4bool tf) { fBoundaryVertexSearch = tf; };
+  //! Rate of the 3g vertices and navigator locates per vertex search in this thread since the last reset
+  void PrintStatistics() const;
+  void ResetStatistics();
 
 private:
   //! return: vtx position, 2/3g ratio, meanlifetime;
@@ -46,8 +55,16 @@ private:
   std::tuple<G4ThreeVector, MaterialExtension*> GetVerticesDistributionInFilledSphere(
     const G4ThreeVector center, G4double radius
   );
+  //! return: first point center + n * step (n = 0, 1, ...) lying in a target material
   std::tuple<G4ThreeVector, MaterialExtension*> GetVerticesDistributionAlongStepVector(
-    const G4ThreeVector center, const G4ThreeVector direction
+    const G4ThreeVector center, const G4ThreeVector step
+  );
+  std::tuple<G4ThreeVector, MaterialExtension*> GetVerticesDistributionWithFixedStep(
+    const G4ThreeVector center, const G4ThreeVector step
+  );
+  //! 2g or 3g vertex of the decay channel and lifetime component drawn from the material
+  void GenerateAnnihilationVertex(
+    G4Event* event, const MaterialExtension* material, const G4ThreeVector vtxPosition, const G4double T0
   );
   G4PrimaryVertex* GenerateTwoGammaVertex(
     const G4ThreeVector vtxPosition, const G4double T0, const G4double lifetime2g
@@ -55,6 +72,9 @@ private:
   G4PrimaryVertex* GenerateThreeGammaVertex(
     const MaterialExtension::DecayChannel channel, const G4ThreeVector vtxPosition, const G4double T0, const G4double lifetime3g
   );
+  void GenerateThreeGammaMomentaWithPhaseSpace(
+    const MaterialExtension::DecayChannel channel, G4ThreeVector momenta[3]
+  );
   G4PrimaryVertex* GeneratePromptGammaVertex(
     const G4ThreeVector vtxPosition, const G4double T0, const G4double lifetimePrompt, const G4double energy
   );
@@ -65,6 +85,30 @@ private:
   const G4ThreeVector GetRandomPointInFilledSphere(G4double radius);
   const G4ThreeVector GetRandomPointOnSphere(G4double radius);
   
+  //! Target voxels of the sphere used in GetVerticesDistributionInFilledSphere
+  TargetVoxelMap fTargetMap;
+  //! Set up once with the decay of positronium at rest, reused for every vertex
+  TGenPhaseSpace fTwoGammaPhaseSpace;
+  TGenPhaseSpace fThreeGammaPhaseSpace;
+  G4ParticleDefinition* fGamma = nullptr;
+  G4bool fUseThreeGammaTable = true;
+  G4long fThreeGammaVertices = 0;
+  //! Time spent in drawing the momenta of 3g vertices [s]
+  G4double fThreeGammaTime = 0.0;
+  G4bool fBoundaryVertexSearch = true;
+  G4long fVertexSearches = 0;
+  G4long fVertexSearchLocates = 0;
+  //! Used only for the traversal of the ray, does not disturb the tracking navigator
+  G4Navigator fRayNavigator;
+
+  RunMetrics* fMetrics = RunMetrics::GetInstance();
+  MetricHandle fTwoGammaVertexCount = fMetrics->Counter("vertices.twoGamma");
+  MetricHandle fThreeGammaVertexCount = fMetrics->Counter("vertices.threeGamma");
+  MetricHandle fPromptVertexCount = fMetrics->Counter("vertices.prompt");
+  MetricHandle fVertexSearchCount = fMetrics->Counter("vertices.searches");
+  MetricHandle fVertexSearchLocateCount = fMetrics->Counter("vertices.searchLocates");
+  MetricHandle fThreeGammaMomentaTime = fMetrics->Timer("generator.threeGammaMomenta");
+
   G4Navigator* theNavigator =  G4TransportationManager::GetTransportationManager()
   ->GetNavigatorForTracking();
 };
@@ -0,0 +1,91 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file ProgressReporter.cpp
+ */
+
+#include "ProgressReporter.h"
+
+#include <G4SystemOfUnits.hh>
+#include <unistd.h>
+#include <cstdio>
+
+ProgressReporter* ProgressReporter::GetInstance()
+{
+  static ProgressReporter instance;
+  return &instance;
+}
+
+void ProgressReporter::Start(G4long totalEvents, G4double interval)
+{
+  fStart = std::chrono::steady_clock::now();
+  fTotalEvents = totalEvents;
+  fInterval = interval / s;
+  fProcessed = 0;
+  fGenerated = 0;
+  fNextReport = fInterval;
+}
+
+/**
+ * Reading the clock is the only cost per event; the thread which first sees the report
+ * due moves the next report time forward, the others skip it
+ */
+void ProgressReporter::EventDone(G4int generations)
+{
+  fProcessed++;
+  fGenerated += generations;
+  G4double elapsed = std::chrono::duration<G4double>(std::chrono::steady_clock::now() - fStart).count();
+  G4double due = fNextReport.load();
+  if (elapsed < due) return;
+  if (fNextReport.compare_exchange_strong(due, elapsed + fInterval)) {
+    Report(elapsed);
+  }
+}
+
+void ProgressReporter::Finish()
+{
+  Report(std::chrono::duration<G4double>(std::chrono::steady_clock::now() - fStart).count());
+}
+
+void ProgressReporter::Report(G4double elapsed) const
+{
+  G4long processed = fProcessed.load();
+  G4long generated = fGenerated.load();
+  G4double rate = elapsed > 0.0 ? processed / elapsed : 0.0;
+  G4double percent = fTotalEvents > 0 ? 100.0 * processed / fTotalEvents : 0.0;
+  G4double accepted = generated > 0 ? G4double(processed) / generated : 1.0;
+  G4long eta = rate > 0.0 ? static_cast<G4long>((fTotalEvents - processed) / rate) : 0;
+  G4double memory = GetResidentMemory();
+  char line[256];
+  snprintf(
+    line, sizeof(line),
+    " === Progress %5.1f %% | %ld events | %.1f events/s | accepted/generated %.4f | ETA %02ld:%02ld:%02ld",
+    percent, processed, rate, accepted, eta / 3600, (eta / 60) % 60, eta % 60
+  );
+  if (memory >= 0.0) {
+    printf("%s | RSS %.0f MB\n", line, memory);
+  } else {
+    printf("%s\n", line);
+  }
+  fflush(stdout);
+}
+
+G4double ProgressReporter::GetResidentMemory()
+{
+  FILE* statm = fopen("/proc/self/statm", "r");
+  if (!statm) return -1.0;
+  long size = 0, resident = 0;
+  int read = fscanf(statm, "%ld %ld", &size, &resident);
+  fclose(statm);
+  if (read != 2) return -1.0;
+  return resident * static_cast<G4double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+}
@@ -0,0 +1,54 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file ProgressReporter.h
+ */
+
+#ifndef PROGRESSREPORTER_H
+#define PROGRESSREPORTER_H 1
+
+#include <globals.hh>
+#include <atomic>
+#include <chrono>
+
+/**
+ * @class ProgressReporter
+ * @brief prints progress of the run on a wall-clock interval: events/s, accepted/generated
+ * events, ETA and resident memory; shared by all threads, only one of them prints a report
+ */
+class ProgressReporter
+{
+public:
+  static ProgressReporter* GetInstance();
+  //! Called by the master before the event loop, interval in Geant4 time units
+  void Start(G4long totalEvents, G4double interval);
+  //! Called by the thread which completed the event, with the number of its generations
+  void EventDone(G4int generations);
+  //! Final report at the end of the run
+  void Finish();
+
+private:
+  ProgressReporter() {}
+  void Report(G4double elapsed) const;
+  //! Resident set size of the process [MB], negative if unknown
+  static G4double GetResidentMemory();
+
+  std::chrono::steady_clock::time_point fStart;
+  G4long fTotalEvents = 0;
+  G4double fInterval = 10.0;
+  std::atomic<G4long> fProcessed{0};
+  std::atomic<G4long> fGenerated{0};
+  //! Seconds since the start when the next report is due, claimed by a single thread
+  std::atomic<G4double> fNextReport{0.0};
+};
+
+#endif /* !PROGRESSREPORTER_H */
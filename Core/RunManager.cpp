@@ -14,6 +14,7 @@
  */
 
 #include "../Actions/EventAction.h"
+#include "ProgressReporter.h"
 #include "RunManager.h"
 
 // cppcheck-suppress unusedFunction
@@ -25,15 +26,11 @@ void RunManager::DoEventLoop(G4int n_event, const char* macroFile, G4int n_selec
   //! Event loop
   for (G4int i_event = 0; i_event < n_event; i_event++) {
 
-    if (fEvtMessenger->PrintStatistics()
-    && (i_event % int(pow(10, fEvtMessenger->GetPowerPrintStat())) == 0)) {
+    if (fEvtMessenger->PrintStatistics() && (i_event % fEvtMessenger->GetPrintDivisor() == 0)) {
       printf(" === Processed %i events \n", i_event);
     }
 
-    if (fEvtMessenger->ShowProgress()){
-      printf(" === Progress %4.2f === \r", double(100 * i_event) / double(n_event));
-    }
-
+    G4int generations = 1;
     if (fEvtMessenger->KillEventsEscapingWorld()) {
       bool isAborted = true;
       while (isAborted) {
@@ -42,11 +39,18 @@ void RunManager::DoEventLoop(G4int n_event, const char* macroFile, G4int n_selec
         if (isAborted) {
           //! clean event - it will not be stored
           delete currentEvent;
+          generations++;
         }
       }
     } else {
       ProcessOneEvent(i_event);
     }
+    fMetrics->Add(fProcessedEvents);
+    fMetrics->Add(fGeneratedEvents, generations);
+    fMetrics->Add(fRegeneratedEvents, generations - 1);
+    if (fEvtMessenger->ShowProgress()) {
+      ProgressReporter::GetInstance()->EventDone(generations);
+    }
     //! updating counters
     TerminateOneEvent();
     if (runAborted) {
@@ -17,6 +17,7 @@
 #define RUNMANAGER_H 1
 
 #include "../Info/EventMessenger.h"
+#include "RunMetrics.h"
 #include <G4RunManager.hh>
 
 class RunManager : public G4RunManager
@@ -26,6 +27,10 @@ public:
 
 private:
   EventMessenger* fEvtMessenger = EventMessenger::GetEventMessenger();
+  RunMetrics* fMetrics = RunMetrics::GetInstance();
+  MetricHandle fProcessedEvents = fMetrics->Counter("events.processed");
+  MetricHandle fGeneratedEvents = fMetrics->Counter("events.generated");
+  MetricHandle fRegeneratedEvents = fMetrics->Counter("events.regenerated");
 };
 
 #endif /* !RUNMANAGER_H */
@@ -0,0 +1,126 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file RunMetrics.cpp
+ */
+
+#include "RunMetrics.h"
+
+#include <G4Threading.hh>
+#include <G4AutoLock.hh>
+#include <algorithm>
+#include <sstream>
+#include <chrono>
+#include <map>
+
+namespace
+{
+  //! Metrics of all threads, added up by the master
+  std::vector<RunMetrics*> threadMetrics;
+  G4Mutex threadMetricsMutex = G4MUTEX_INITIALIZER;
+  std::chrono::steady_clock::time_point runStart;
+  G4int currentRunID = -1;
+  G4long requestedEventsInRun = 0;
+
+  MetricHandle FindOrAdd(std::vector<std::string>& names, const std::string& name)
+  {
+    MetricHandle handle;
+    auto it = std::find(names.begin(), names.end(), name);
+    handle.fIndex = it - names.begin();
+    if (it == names.end()) names.push_back(name);
+    return handle;
+  }
+}
+
+RunMetrics* RunMetrics::GetInstance()
+{
+  static G4ThreadLocal RunMetrics* instance = nullptr;
+  if (!instance) {
+    instance = new RunMetrics();
+    G4AutoLock lock(&threadMetricsMutex);
+    threadMetrics.push_back(instance);
+  }
+  return instance;
+}
+
+MetricHandle RunMetrics::Counter(const std::string& name)
+{
+  MetricHandle handle = FindOrAdd(fCounterNames, name);
+  fCounterValues.resize(fCounterNames.size(), 0);
+  return handle;
+}
+
+MetricHandle RunMetrics::Timer(const std::string& name)
+{
+  MetricHandle handle = FindOrAdd(fTimerNames, name);
+  fTimerValues.resize(fTimerNames.size(), 0.0);
+  fTimerCalls.resize(fTimerNames.size(), 0);
+  return handle;
+}
+
+void RunMetrics::Reset()
+{
+  std::fill(fCounterValues.begin(), fCounterValues.end(), 0);
+  std::fill(fTimerValues.begin(), fTimerValues.end(), 0.0);
+  std::fill(fTimerCalls.begin(), fTimerCalls.end(), 0);
+}
+
+void RunMetrics::StartRun(G4int runID, G4long requestedEvents)
+{
+  runStart = std::chrono::steady_clock::now();
+  currentRunID = runID;
+  requestedEventsInRun = requestedEvents;
+}
+
+/**
+ * Called by the master after the workers finished the run; metric names are sorted,
+ * so the files of different jobs can be compared line by line
+ */
+std::string RunMetrics::ToJSON()
+{
+  G4double wallTime = std::chrono::duration<G4double>(std::chrono::steady_clock::now() - runStart).count();
+  std::map<std::string, G4long> counters;
+  std::map<std::string, std::pair<G4double, G4long>> timers;
+  G4AutoLock lock(&threadMetricsMutex);
+  for (const RunMetrics* metrics : threadMetrics) {
+    for (std::size_t i = 0; i < metrics->fCounterNames.size(); i++) {
+      counters[metrics->fCounterNames[i]] += metrics->fCounterValues[i];
+    }
+    for (std::size_t i = 0; i < metrics->fTimerNames.size(); i++) {
+      auto& timer = timers[metrics->fTimerNames[i]];
+      timer.first += metrics->fTimerValues[i];
+      timer.second += metrics->fTimerCalls[i];
+    }
+  }
+
+  std::ostringstream json;
+  json << "{\n  \"runID\": " << currentRunID
+    << ",\n  \"threads\": " << std::max(1, G4Threading::GetNumberOfRunningWorkerThreads())
+    << ",\n  \"requestedEvents\": " << requestedEventsInRun
+    << ",\n  \"wallTime\": " << wallTime
+    << ",\n  \"eventsPerSecond\": " << (wallTime > 0 ? requestedEventsInRun / wallTime : 0.0)
+    << ",\n  \"counters\": {";
+  const char* separator = "\n";
+  for (const auto& counter : counters) {
+    json << separator << "    \"" << counter.first << "\": " << counter.second;
+    separator = ",\n";
+  }
+  json << "\n  },\n  \"timers\": {";
+  separator = "\n";
+  for (const auto& timer : timers) {
+    json << separator << "    \"" << timer.first << "\": {\"seconds\": " << timer.second.first
+      << ", \"calls\": " << timer.second.second << "}";
+    separator = ",\n";
+  }
+  json << "\n  }\n}\n";
+  return json.str();
+}
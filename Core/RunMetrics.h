@@ -0,0 +1,70 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file RunMetrics.h
+ */
+
+#ifndef RUNMETRICS_H
+#define RUNMETRICS_H 1
+
+#include <globals.hh>
+#include <string>
+#include <vector>
+
+//! Index of a counter or a timer in the metrics of the thread which registered it
+struct MetricHandle {
+  int fIndex = -1;
+};
+
+/**
+ * @class RunMetrics
+ * @brief counters and timers of the run; every thread fills its own instance,
+ * the master adds them up by name at the end of the run and exports them as JSON
+ */
+class RunMetrics
+{
+public:
+  //! Metrics of the calling thread
+  static RunMetrics* GetInstance();
+
+  //! Registered once, e.g. in the constructor of the class filling the metric
+  MetricHandle Counter(const std::string& name);
+  MetricHandle Timer(const std::string& name);
+
+  void Add(MetricHandle counter, G4long value = 1) { fCounterValues[counter.fIndex] += value; };
+  //! Time in seconds
+  void AddTime(MetricHandle timer, G4double time, G4long calls = 1)
+  {
+    fTimerValues[timer.fIndex] += time;
+    fTimerCalls[timer.fIndex] += calls;
+  };
+  //! Lookup by name, for metrics filled once per run
+  void Add(const std::string& name, G4long value) { Add(Counter(name), value); };
+  void AddTime(const std::string& name, G4double time, G4long calls = 1) { AddTime(Timer(name), time, calls); };
+
+  //! Called by every thread at the beginning of the run; handles stay valid
+  void Reset();
+  //! Called by the master at the beginning of the run, starts the wall clock
+  static void StartRun(G4int runID, G4long requestedEvents);
+  //! Metrics of all threads added up, with run wall time and throughput, in JSON format
+  static std::string ToJSON();
+
+private:
+  RunMetrics() {}
+  std::vector<std::string> fCounterNames;
+  std::vector<G4long> fCounterValues;
+  std::vector<std::string> fTimerNames;
+  std::vector<G4double> fTimerValues;
+  std::vector<G4long> fTimerCalls;
+};
+
+#endif /* !RUNMETRICS_H */
@@ -0,0 +1,99 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file TargetVoxelMap.cpp
+ */
+
+#include "DetectorConstruction.h"
+#include "TargetVoxelMap.h"
+
+#include <G4TransportationManager.hh>
+#include <G4VPhysicalVolume.hh>
+#include <Randomize.hh>
+#include <cfloat>
+#include <cmath>
+
+void TargetVoxelMap::Update(const G4ThreeVector& center, G4double radius)
+{
+  G4int geometryVersion = DetectorConstruction::GetInstance()->GetGeometryVersion();
+  if (center == fCenter && radius == fRadius && geometryVersion == fGeometryVersion) {
+    return;
+  }
+  fCenter = center;
+  fRadius = radius;
+  fGeometryVersion = geometryVersion;
+  Build();
+}
+
+/**
+ * Voxel is filled by the volume of its center if the safety at the center exceeds
+ * the half diagonal of the voxel - such voxels are kept only if the material is a target.
+ * Voxels crossed by a boundary are kept and resolved by the navigator when sampling.
+ */
+void TargetVoxelMap::Build()
+{
+  fVoxels.clear();
+  fVoxelSize = 2 * fRadius / kVoxels;
+  G4double halfDiagonal = std::sqrt(3.0) * fVoxelSize / 2;
+  fNavigator.SetWorldVolume(
+    G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume()
+  );
+
+  G4ThreeVector origin = fCenter - G4ThreeVector(fRadius, fRadius, fRadius);
+  for (G4int i = 0; i < kVoxels; i++) {
+    for (G4int j = 0; j < kVoxels; j++) {
+      for (G4int k = 0; k < kVoxels; k++) {
+        G4ThreeVector corner = origin + fVoxelSize * G4ThreeVector(i, j, k);
+        G4ThreeVector voxelCenter = corner + 0.5 * fVoxelSize * G4ThreeVector(1, 1, 1);
+        G4double distance = (voxelCenter - fCenter).mag();
+        if (distance - halfDiagonal > fRadius) continue;
+
+        G4VPhysicalVolume* volume = fNavigator.LocateGlobalPointAndSetup(voxelCenter, nullptr, false, true);
+        if (!volume) continue;
+        MaterialExtension* material = dynamic_cast<MaterialExtension*>(
+          volume->GetLogicalVolume()->GetMaterial()
+        );
+        G4double safety = fNavigator.ComputeSafety(voxelCenter, DBL_MAX, true);
+        G4bool isFilled = safety >= halfDiagonal;
+        if (isFilled && !(material && material->IsTarget())) continue;
+        fVoxels.push_back({corner, isFilled ? material : nullptr, distance + halfDiagonal <= fRadius});
+      }
+    }
+  }
+
+  if (fVoxels.empty()) {
+    G4Exception(
+      "TargetVoxelMap", "PG07", FatalException,
+      "No target material found around the chamber center"
+    );
+  }
+  //! Voxels have equal volumes, rejection in Sample makes the points uniform in the target
+  fTable.Build(std::vector<G4double>(fVoxels.size(), 1.0));
+}
+
+std::tuple<G4ThreeVector, MaterialExtension*> TargetVoxelMap::Sample(G4Navigator* navigator) const
+{
+  while (true) {
+    const Voxel& voxel = fVoxels[fTable.Sample(G4UniformRand())];
+    G4ThreeVector point = voxel.fCorner + fVoxelSize * G4ThreeVector(G4UniformRand(), G4UniformRand(), G4UniformRand());
+    if (!voxel.fInsideSphere && (point - fCenter).mag2() > fRadius * fRadius) continue;
+    if (voxel.fMaterial) {
+      return std::make_tuple(point, voxel.fMaterial);
+    }
+    MaterialExtension* material = dynamic_cast<MaterialExtension*>(
+      navigator->LocateGlobalPointAndSetup(point)->GetLogicalVolume()->GetMaterial()
+    );
+    if (material && material->IsTarget()) {
+      return std::make_tuple(point, material);
+    }
+  }
+}
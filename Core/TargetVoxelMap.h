@@ -0,0 +1,66 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file TargetVoxelMap.h
+ */
+
+#ifndef TARGETVOXELMAP_H
+#define TARGETVOXELMAP_H 1
+
+#include "MaterialExtension.h"
+#include "AliasTable.h"
+
+#include <G4ThreeVector.hh>
+#include <G4Navigator.hh>
+#include <globals.hh>
+#include <vector>
+#include <tuple>
+
+/**
+ * @class TargetVoxelMap
+ * @brief voxel grid over a sphere, keeps only voxels that can contain target material;
+ * annihilation points uniform in the target inside the sphere are drawn with navigation
+ * only in voxels crossed by a volume boundary
+ */
+class TargetVoxelMap
+{
+public:
+  TargetVoxelMap() {}
+  //! Rebuilds the map if the geometry, the center or the radius of the sphere changed
+  void Update(const G4ThreeVector& center, G4double radius);
+  //! Point uniform in target materials inside the sphere and its material
+  std::tuple<G4ThreeVector, MaterialExtension*> Sample(G4Navigator* navigator) const;
+
+private:
+  struct Voxel {
+    //! Corner of the voxel with the lowest coordinates
+    G4ThreeVector fCorner;
+    //! Target material filling the whole voxel, nullptr if the voxel is crossed by a boundary
+    MaterialExtension* fMaterial;
+    G4bool fInsideSphere;
+  };
+  void Build();
+
+  //! Voxels along each axis of the cube enclosing the sphere
+  static const G4int kVoxels = 32;
+
+  G4ThreeVector fCenter;
+  G4double fRadius = -1.0;
+  G4int fGeometryVersion = -1;
+  G4double fVoxelSize = 0.0;
+  std::vector<Voxel> fVoxels;
+  AliasTable fTable;
+  //! Used only for building the map, does not disturb the tracking navigator
+  G4Navigator fNavigator;
+};
+
+#endif /* !TARGETVOXELMAP_H */
@@ -0,0 +1,166 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file ThreeGammaSampler.cpp
+ */
+
+#include "ThreeGammaSampler.h"
+
+#include <G4PhysicalConstants.hh>
+#include <G4RandomDirection.hh>
+#include <G4SystemOfUnits.hh>
+#include <Randomize.hh>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  //! Electron mass in keV, energies in the Dalitz plot are in keV
+  const G4double kMass = 511.0;
+  //! Number of bins of the Dalitz plot in w1 and w2, 2 keV wide
+  const G4int kBins = 256;
+  const G4double kBinWidth = kMass / kBins;
+  //! Intervals per bin (in each direction) of the grid used to find the maximum of the density in the bin
+  const G4int kSubBins = 6;
+  //! Keeps the grid points off the edges of the plot, where the density is not defined [keV]
+  const G4double kEpsilon = 1e-6;
+  //! Safety factor on the maximum of the density found in the bin
+  const G4double kBoundMargin = 1.2;
+}
+
+const ThreeGammaSampler& ThreeGammaSampler::GetSampler(MaterialExtension::DecayChannel channel)
+{
+  static const ThreeGammaSampler orthoSampler(MaterialExtension::DecayChannel::Ortho3G);
+  static const ThreeGammaSampler paraSampler(MaterialExtension::DecayChannel::Para3G);
+  if (channel == MaterialExtension::DecayChannel::Para3G) {
+    return paraSampler;
+  }
+  return orthoSampler;
+}
+
+/**
+ * Ore-Powell distribution for o-Ps (and direct annihilation), for p-Ps:
+ * sin(acos(x)) = sqrt(1 - x^2), angles between gamma quanta are given by their energies
+ */
+G4double ThreeGammaSampler::MatrixElement(
+  MaterialExtension::DecayChannel channel, G4double mass_e, G4double w1, G4double w2, G4double w3
+) {
+  if (channel == MaterialExtension::DecayChannel::Ortho3G || channel == MaterialExtension::DecayChannel::Direct) {
+    G4double a1 = (mass_e - w1) / (w2 * w3);
+    G4double a2 = (mass_e - w2) / (w1 * w3);
+    G4double a3 = (mass_e - w3) / (w1 * w2);
+    return a1 * a1 + a2 * a2 + a3 * a3;
+  } else if (channel == MaterialExtension::DecayChannel::Para3G) {
+    G4double c12 = (-w1 * w1 - w2 * w2 + w3 * w3) / (2 * w1 * w2);
+    G4double c23 = (w1 * w1 - w2 * w2 - w3 * w3) / (2 * w3 * w2);
+    G4double c13 = (-w1 * w1 + w2 * w2 - w3 * w3) / (2 * w1 * w3);
+    G4double sines =
+      std::sqrt(std::max(0.0, 1 - c12 * c12)) + std::sqrt(std::max(0.0, 1 - c23 * c23))
+      + std::sqrt(std::max(0.0, 1 - c13 * c13));
+    G4double product = w1 * w2 * w3;
+    return product * product * sines * sines * (
+      (mass_e - w3) * (mass_e - w3) * (w1 - w2) * (w1 - w2)
+      + (mass_e - w1) * (mass_e - w1) * (w2 - w3) * (w2 - w3)
+      + (mass_e - w2) * (mass_e - w2) * (w3 - w1) * (w3 - w1)
+    );
+  }
+  return 0;
+}
+
+/**
+ * Phase space of three massless particles is uniform in the Dalitz plot (w1, w2),
+ * allowed region is the triangle w1, w2, w3 = 2m - w1 - w2 <= m.
+ * Bin weight is the bound of the density in the bin, the point drawn uniformly in the bin
+ * is accepted with density/bound - the energies follow the matrix element exactly,
+ * the table only makes the rejection efficient.
+ */
+ThreeGammaSampler::ThreeGammaSampler(MaterialExtension::DecayChannel channel) : fChannel(channel)
+{
+  fBound.assign(kBins * kBins, 0.0);
+  for (G4int i = 0; i < kBins; i++) {
+    for (G4int j = 0; j < kBins; j++) {
+      //! Bin lies wholly outside the plot
+      if ((i + j + 2) * kBinWidth <= kMass) continue;
+      G4double bound = 0.0;
+      //! Edges of the bin included, the p-Ps density is steepest at the edges of the plot
+      for (G4int k = 0; k <= kSubBins; k++) {
+        for (G4int l = 0; l <= kSubBins; l++) {
+          G4double w1 = std::min(kMass - kEpsilon, std::max(kEpsilon, (i + G4double(k) / kSubBins) * kBinWidth));
+          G4double w2 = std::min(kMass - kEpsilon, std::max(kEpsilon, (j + G4double(l) / kSubBins) * kBinWidth));
+          //! Points below the edge w3 = m of the plot are moved onto it
+          G4double deficit = kMass - w1 - w2;
+          if (deficit > 0.0) {
+            w1 += deficit / 2 + kEpsilon;
+            w2 += deficit / 2 + kEpsilon;
+          }
+          bound = std::max(bound, Density(w1, w2));
+        }
+      }
+      fBound[i * kBins + j] = kBoundMargin * bound;
+    }
+  }
+  fTable.Build(fBound);
+}
+
+G4double ThreeGammaSampler::Density(G4double w1, G4double w2) const
+{
+  G4double w3 = 2 * kMass - w1 - w2;
+  if (w1 <= 0.0 || w2 <= 0.0 || w1 > kMass || w2 > kMass || w3 > kMass) {
+    return 0.0;
+  }
+  return MatrixElement(fChannel, kMass, w1, w2, w3);
+}
+
+void ThreeGammaSampler::SampleEnergies(G4double& w1, G4double& w2) const
+{
+  while (true) {
+    std::size_t bin = fTable.Sample(G4UniformRand());
+    G4int i = bin / kBins;
+    G4int j = bin % kBins;
+    w1 = (i + G4UniformRand()) * kBinWidth;
+    w2 = (j + G4UniformRand()) * kBinWidth;
+    G4double density = Density(w1, w2);
+    if (density == 0.0) continue;
+    static G4ThreadLocal bool warned = false;
+    if (density > fBound[bin] && !warned) {
+      warned = true;
+      G4Exception(
+        "ThreeGammaSampler", "PG06", JustWarning,
+        "Density exceeds its tabulated bound, 3g energies are slightly biased"
+      );
+    }
+    if (G4UniformRand() * fBound[bin] < density) return;
+  }
+}
+
+/**
+ * Momenta lie in a plane: first gamma along u, second at the angle given by the energies,
+ * third balances the momentum; u is isotropic and the plane is rotated uniformly around u.
+ */
+void ThreeGammaSampler::Sample(G4ThreeVector momenta[3]) const
+{
+  G4double w1, w2;
+  SampleEnergies(w1, w2);
+  G4double w3 = 2 * kMass - w1 - w2;
+  G4double cosTheta = std::max(-1.0, std::min(1.0, (w3 * w3 - w1 * w1 - w2 * w2) / (2 * w1 * w2)));
+  G4double sinTheta = std::sqrt(1.0 - cosTheta * cosTheta);
+
+  G4ThreeVector u = G4RandomDirection();
+  G4ThreeVector a = u.orthogonal().unit();
+  G4ThreeVector b = u.cross(a);
+  G4double psi = twopi * G4UniformRand();
+  G4ThreeVector v = std::cos(psi) * a + std::sin(psi) * b;
+
+  momenta[0] = w1 * keV * u;
+  momenta[1] = w2 * keV * (cosTheta * u + sinTheta * v);
+  momenta[2] = -(momenta[0] + momenta[1]);
+}
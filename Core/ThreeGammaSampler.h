@@ -0,0 +1,54 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file ThreeGammaSampler.h
+ */
+
+#ifndef THREEGAMMASAMPLER_H
+#define THREEGAMMASAMPLER_H 1
+
+#include "MaterialExtension.h"
+#include "AliasTable.h"
+
+#include <G4ThreeVector.hh>
+#include <globals.hh>
+#include <vector>
+
+/**
+ * @class ThreeGammaSampler
+ * @brief samples momenta of gamma quanta from the 3g decay of positronium at rest;
+ * energies are drawn from the tabulated Dalitz plot density of the decay channel, orientation is isotropic
+ */
+class ThreeGammaSampler
+{
+public:
+  //! Sampler of the channel (Ortho3G and Direct share one); tables are built on first use and shared by threads
+  static const ThreeGammaSampler& GetSampler(MaterialExtension::DecayChannel channel);
+  //! Squared matrix element of the channel, energies in keV
+  static G4double MatrixElement(
+    MaterialExtension::DecayChannel channel, G4double mass_e, G4double w1, G4double w2, G4double w3
+  );
+  void Sample(G4ThreeVector momenta[3]) const;
+
+private:
+  explicit ThreeGammaSampler(MaterialExtension::DecayChannel channel);
+  //! Energies (in keV) of the gamma quanta distributed as the matrix element over the Dalitz plot
+  void SampleEnergies(G4double& w1, G4double& w2) const;
+  G4double Density(G4double w1, G4double w2) const;
+
+  MaterialExtension::DecayChannel fChannel;
+  //! Bins drawn proportionally to bound of the density times bin area
+  AliasTable fTable;
+  std::vector<G4double> fBound;
+};
+
+#endif /* !THREEGAMMASAMPLER_H */
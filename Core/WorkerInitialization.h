@@ -0,0 +1,31 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file WorkerInitialization.h
+ */
+
+#ifndef WORKERINITIALIZATION_H
+#define WORKERINITIALIZATION_H 1
+
+#include <G4UserWorkerThreadInitialization.hh>
+
+/**
+ * @class WorkerInitialization
+ * @brief creates WorkerRunManager for each worker thread in the multithreaded mode
+ */
+class WorkerInitialization : public G4UserWorkerThreadInitialization
+{
+public:
+  G4WorkerRunManager* CreateWorkerRunManager() const override;
+};
+
+#endif /* !WORKERINITIALIZATION_H */
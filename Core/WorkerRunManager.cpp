@@ -0,0 +1,57 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file WorkerRunManager.cpp
+ */
+
+#include "ProgressReporter.h"
+#include "WorkerRunManager.h"
+
+#include <G4VUserPrimaryGeneratorAction.hh>
+#include <G4EventManager.hh>
+#include <G4Event.hh>
+
+// cppcheck-suppress unusedFunction
+void WorkerRunManager::ProcessOneEvent(G4int i_event)
+{
+  //! Event ID and random seeds are received from the master here
+  G4WorkerRunManager::ProcessOneEvent(i_event);
+
+  G4int generations = 1;
+  if (fEvtMessenger->KillEventsEscapingWorld()) {
+    //! Aborted event is generated again under the same event ID, so that the master
+    //! does not have to hand out additional events to keep the requested statistics
+    while (currentEvent && currentEvent->IsAborted()) {
+      G4int eventID = currentEvent->GetEventID();
+      //! clean event - it will not be stored
+      delete currentEvent;
+      currentEvent = new G4Event(eventID);
+      userPrimaryGeneratorAction->GeneratePrimaries(currentEvent);
+      eventManager->ProcessOneEvent(currentEvent);
+      AnalyzeEvent(currentEvent);
+      UpdateScoring();
+      generations++;
+    }
+  }
+
+  //! Event with negative ID means that the master has no more events to process
+  if (!currentEvent || currentEvent->GetEventID() < 0) return;
+  if (fEvtMessenger->PrintStatistics() && (currentEvent->GetEventID() % fEvtMessenger->GetPrintDivisor() == 0)) {
+    printf(" === Processed %i events \n", currentEvent->GetEventID());
+  }
+  fMetrics->Add(fProcessedEvents);
+  fMetrics->Add(fGeneratedEvents, generations);
+  fMetrics->Add(fRegeneratedEvents, generations - 1);
+  if (fEvtMessenger->ShowProgress()) {
+    ProgressReporter::GetInstance()->EventDone(generations);
+  }
+}
@@ -0,0 +1,41 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file WorkerRunManager.h
+ */
+
+#ifndef WORKERRUNMANAGER_H
+#define WORKERRUNMANAGER_H 1
+
+#include "../Info/EventMessenger.h"
+#include "RunMetrics.h"
+#include <G4WorkerRunManager.hh>
+
+/**
+ * @class WorkerRunManager
+ * @brief run manager of a single worker thread in the multithreaded mode;
+ * repeats events aborted by saveEvtsDetAcc the same way as RunManager does
+ */
+class WorkerRunManager : public G4WorkerRunManager
+{
+public:
+  void ProcessOneEvent(G4int i_event) override;
+
+private:
+  EventMessenger* fEvtMessenger = EventMessenger::GetEventMessenger();
+  RunMetrics* fMetrics = RunMetrics::GetInstance();
+  MetricHandle fProcessedEvents = fMetrics->Counter("events.processed");
+  MetricHandle fGeneratedEvents = fMetrics->Counter("events.generated");
+  MetricHandle fRegeneratedEvents = fMetrics->Counter("events.regenerated");
+};
+
+#endif /* !WORKERRUNMANAGER_H */
@@ -20,7 +20,8 @@ DetectorConstructionMessenger::DetectorConstructionMessenger() {}
 
 DetectorConstructionMessenger::DetectorConstructionMessenger(DetectorConstruction* detector) : fDetector(detector)
 {
-  fDirectory = new G4UIdirectory("/jpetmc/detector/");
+  //! Geometry is built by the master - commands are not broadcasted to workers
+  fDirectory = new G4UIdirectory("/jpetmc/detector/", false);
   fDirectory->SetGuidance("Commands for controling the geometry");
 
   fLoadTargetForRun = new G4UIcmdWithAnInteger("/jpetmc/detector/loadTargetForRun", this);
@@ -56,6 +57,31 @@ DetectorConstructionMessenger::DetectorConstructionMessenger(DetectorConstructio
   fPressureInChamber->SetGuidance("Define pressure in the chamber");
   fPressureInChamber->SetDefaultUnit("Pa");
   fPressureInChamber->SetUnitCandidates("Pa");
+
+  fWrapping = new G4UIcmdWithAString("/jpetmc/detector/wrapping", this);
+  fWrapping->SetGuidance("Wrapping of the scintillators: nested (shared strip volume, default) or boolean (subtraction solid per copy)");
+  fWrapping->SetCandidates("nested boolean");
+  fWrapping->SetDefaultValue("nested");
+
+  fLayerEnvelopes = new G4UIcmdWithABool("/jpetmc/detector/layerEnvelopes", this);
+  fLayerEnvelopes->SetGuidance("Place each layer of scintillators in its own tube instead of directly in the world");
+  fLayerEnvelopes->SetDefaultValue(false);
+
+  fMeshCache = new G4UIcmdWithABool("/jpetmc/detector/meshCache", this);
+  fMeshCache->SetGuidance("Read facets of the CAD files from the cache, parse the STL file only if it changed");
+  fMeshCache->SetDefaultValue(true);
+
+  fMeshCacheDirectory = new G4UIcmdWithAString("/jpetmc/detector/meshCacheDirectory", this);
+  fMeshCacheDirectory->SetGuidance("Directory of the mesh cache files (by default the directory of the STL file)");
+
+  fFrameModel = new G4UIcmdWithAString("/jpetmc/detector/frameModel", this);
+  fFrameModel->SetGuidance("CAD frame as a single tessellated solid (mesh, default) or split into separate bodies (bodies)");
+  fFrameModel->SetCandidates("mesh bodies");
+  fFrameModel->SetDefaultValue("mesh");
+
+  fLoadGeometryFile = new G4UIcmdWithAString("/jpetmc/detector/loadGeometryFile", this);
+  fLoadGeometryFile->SetGuidance("Build scintillators and targets from a JSON description instead of the code (none - switch off)");
+  fLoadGeometryFile->SetDefaultValue("none");
 }
 
 DetectorConstructionMessenger::~DetectorConstructionMessenger()
@@ -69,6 +95,12 @@ DetectorConstructionMessenger::~DetectorConstructionMessenger()
   delete fGeometryFileName;
   delete fCreateGeometryType;
   delete fPressureInChamber;
+  delete fWrapping;
+  delete fLayerEnvelopes;
+  delete fMeshCache;
+  delete fMeshCacheDirectory;
+  delete fFrameModel;
+  delete fLoadGeometryFile;
 }
 
 // cppcheck-suppress unusedFunction
@@ -106,5 +138,21 @@ void DetectorConstructionMessenger::SetNewValue(G4UIcommand* command, G4String n
     fDetector->SetGeometryFileType(newValue);
   } else if (command == fPressureInChamber) {
     fDetector->SetPressureInChamber(fPressureInChamber->GetNewDoubleValue(newValue));
+  } else if (command == fWrapping) {
+    fDetector->SetNestedWrapping(newValue == "nested");
+    fDetector->UpdateGeometry();
+  } else if (command == fLayerEnvelopes) {
+    fDetector->SetLayerEnvelopes(fLayerEnvelopes->GetNewBoolValue(newValue));
+    fDetector->UpdateGeometry();
+  } else if (command == fMeshCache) {
+    fDetector->SetMeshCache(fMeshCache->GetNewBoolValue(newValue));
+  } else if (command == fMeshCacheDirectory) {
+    fDetector->SetMeshCacheDirectory(newValue);
+  } else if (command == fFrameModel) {
+    fDetector->SetSplitFrame(newValue == "bodies");
+    fDetector->UpdateGeometry();
+  } else if (command == fLoadGeometryFile) {
+    fDetector->LoadGeometryFile(newValue);
+    fDetector->UpdateGeometry();
   }
 }
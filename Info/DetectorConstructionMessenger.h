@@ -51,6 +51,12 @@ private:
   G4UIcmdWithAString* fGeometryFileName = nullptr;
   G4UIcmdWithAString* fCreateGeometryType = nullptr;
   G4UIcmdWithADoubleAndUnit* fPressureInChamber = nullptr;
+  G4UIcmdWithAString* fWrapping = nullptr;
+  G4UIcmdWithABool* fLayerEnvelopes = nullptr;
+  G4UIcmdWithABool* fMeshCache = nullptr;
+  G4UIcmdWithAString* fMeshCacheDirectory = nullptr;
+  G4UIcmdWithAString* fFrameModel = nullptr;
+  G4UIcmdWithAString* fLoadGeometryFile = nullptr;
 };
 
 #endif /* !DETECTORCONSTRUCTIONMESSENGER_H */
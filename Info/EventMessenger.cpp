@@ -16,6 +16,10 @@
 #include "../Core/RunManager.h"
 #include "EventMessenger.h"
 
+#include <exception>
+#include <string>
+#include <cmath>
+
 EventMessenger* EventMessenger::fInstance = nullptr;
 
 EventMessenger* EventMessenger::GetEventMessenger()
@@ -28,12 +32,24 @@ EventMessenger* EventMessenger::GetEventMessenger()
 
 EventMessenger::EventMessenger()
 {
-  fDirectory = new G4UIdirectory("/jpetmc/event/");
+  //! Messenger is shared by all threads - commands are not broadcasted to workers
+  fDirectory = new G4UIdirectory("/jpetmc/event/", false);
   fDirectory->SetGuidance("Define events to save");
 
+  fOutputDirectory = new G4UIdirectory("/jpetmc/output/", false);
+  fOutputDirectory->SetGuidance("Define output of the simulation");
+
   fCMDKillEventsEscapingWorld = new G4UIcmdWithABool("/jpetmc/event/saveEvtsDetAcc", this);
   fCMDKillEventsEscapingWorld->SetGuidance("Killing events when generated particle escapes detector");
 
+  fCMDAcceptanceFilter = new G4UIcmdWithABool("/jpetmc/event/acceptanceFilter", this);
+  fCMDAcceptanceFilter->SetGuidance("Reject events missing the barrel before tracking (works only with saveEvtsDetAcc); def: false");
+
+  fCMDAcceptanceFilterMode = new G4UIcmdWithAString("/jpetmc/event/acceptanceFilterMode", this);
+  fCMDAcceptanceFilterMode->SetGuidance("conservative (default) - reject only if the gamma crosses no volume but the world; approximate - neglect scattering in passive materials");
+  fCMDAcceptanceFilterMode->SetCandidates("conservative approximate");
+  fCMDAcceptanceFilterMode->SetDefaultValue("conservative");
+
   fPrintStat = new G4UIcmdWithABool("/jpetmc/event/printEvtStat", this);
   fPrintStat->SetGuidance("Print how many events was generated");
 
@@ -58,20 +74,30 @@ EventMessenger::EventMessenger()
   fPrintStatBar = new G4UIcmdWithABool("/jpetmc/event/ShowProgress", this);
   fPrintStatBar->SetGuidance("Print how many events was generated (in %)");
 
+  fCMDProgressInterval = new G4UIcmdWithADoubleAndUnit("/jpetmc/event/progressInterval", this);
+  fCMDProgressInterval->SetGuidance("Wall time between progress reports of ShowProgress; def: 10 s");
+  fCMDProgressInterval->SetDefaultUnit("s");
+  fCMDProgressInterval->SetUnitCandidates("s min");
+
   fAddDatetime = new G4UIcmdWithABool("/jpetmc/output/AddDatetime", this);
   fAddDatetime->SetGuidance("Adds to the output file name date and time of simulation start.");
 
-  fSetSeed = new G4UIcmdWithAnInteger("/jpetmc/SetSeed", this);
-  fSetSeed->SetGuidance("Use specific seed. If 0 provided seed will be random.");
-  fSetSeed->SetDefaultValue(0);
+  //! String command, since seeds saved with SaveSeed do not fit in an integer
+  fSetSeed = new G4UIcmdWithAString("/jpetmc/SetSeed", this);
+  fSetSeed->SetGuidance("Use specific seed of the run. If 0 provided seed will be random.");
+  fSetSeed->SetGuidance("Each event is seeded from the run seed and its event ID.");
+  fSetSeed->SetDefaultValue("0");
+  fSetSeed->SetToBeBroadcasted(false);
 
   fSaveSeed = new G4UIcmdWithABool("/jpetmc/SaveSeed", this);
   fSaveSeed->SetGuidance("Save random seed (default false).");
+  fSaveSeed->SetToBeBroadcasted(false);
 
   fCMDAllowedMomentumTransfer = new G4UIcmdWithADoubleAndUnit("/jpetmc/setAllowedMomentumTransfer", this);
   fCMDAllowedMomentumTransfer->SetGuidance("Limit on momentum transfer that will classify interaction as background (10keV)");
   fCMDAllowedMomentumTransfer->SetDefaultValue(1 * keV);
   fCMDAllowedMomentumTransfer->SetUnitCandidates("keV");
+  fCMDAllowedMomentumTransfer->SetToBeBroadcasted(false);
 	
   fCMDAppliedEnergyCut = new G4UIcmdWithADoubleAndUnit("/jpetmc/event/SetEnergyCut",this);
   fCMDAppliedEnergyCut->SetGuidance("Cut on kinetic energy of primary photon after first interaction in scintillator");
@@ -85,6 +111,52 @@ EventMessenger::EventMessenger()
 
   fCreateDecayTree = new G4UIcmdWithABool("/jpetmc/output/CreateDecayTree", this);
   fCreateDecayTree->SetGuidance("Creates decay trees for each event.");
+
+  fCMDAsyncWriter = new G4UIcmdWithABool("/jpetmc/output/asyncWriter", this);
+  fCMDAsyncWriter->SetGuidance("Events are written to the output file by a separate thread (default false).");
+
+  fCMDWriterQueueSize = new G4UIcmdWithAnInteger("/jpetmc/output/writerQueueSize", this);
+  fCMDWriterQueueSize->SetGuidance("Number of preallocated events shared with the writer thread (default 8, minimum 2).");
+  fCMDWriterQueueSize->SetDefaultValue(8);
+
+  fCMDCompressionAlgorithm = new G4UIcmdWithAString("/jpetmc/output/compressionAlgorithm", this);
+  fCMDCompressionAlgorithm->SetGuidance("Compression algorithm of the output file (default - ROOT default).");
+  fCMDCompressionAlgorithm->SetGuidance("lz4 - fast writing, zstd/lzma - smaller files for archiving");
+  fCMDCompressionAlgorithm->SetCandidates("default zlib lzma lz4 zstd");
+  fCMDCompressionAlgorithm->SetDefaultValue("default");
+
+  fCMDCompressionLevel = new G4UIcmdWithAnInteger("/jpetmc/output/compressionLevel", this);
+  fCMDCompressionLevel->SetGuidance("Compression level 0-9 (0 - no compression, default - recommended for the algorithm).");
+  fCMDCompressionLevel->SetParameterName("level", false);
+  fCMDCompressionLevel->SetRange("level >= 0 && level <= 9");
+
+  fCMDBasketSize = new G4UIcmdWithAnInteger("/jpetmc/output/basketSize", this);
+  fCMDBasketSize->SetGuidance("Size of the baskets of the output tree in bytes (default 32000).");
+  fCMDBasketSize->SetDefaultValue(32000);
+
+  fCMDSplitLevel = new G4UIcmdWithAnInteger("/jpetmc/output/splitLevel", this);
+  fCMDSplitLevel->SetGuidance("Split level of the event branch of the output tree (default 2).");
+  fCMDSplitLevel->SetDefaultValue(2);
+
+  fCMDAutoFlush = new G4UIcmdWithAnInteger("/jpetmc/output/autoFlush", this);
+  fCMDAutoFlush->SetGuidance("Flush baskets every N events (N > 0) or every -N bytes (N < 0); default -30000000.");
+  fCMDAutoFlush->SetDefaultValue(-30000000);
+
+  fCMDOutputBackend = new G4UIcmdWithAString("/jpetmc/output/backend", this);
+  fCMDOutputBackend->SetGuidance("Format of the output: ttree - eventPack branch (default), rntuple - columns (ROOT 6.32+)");
+  fCMDOutputBackend->SetCandidates("ttree rntuple");
+  fCMDOutputBackend->SetDefaultValue("ttree");
+
+  fCMDStorePolarization = new G4UIcmdWithABool("/jpetmc/output/storePolarization", this);
+  fCMDStorePolarization->SetGuidance("Polarization of gamma quanta is stored in hits (default true).");
+
+  fCMDStoreMomentum = new G4UIcmdWithABool("/jpetmc/output/storeMomentum", this);
+  fCMDStoreMomentum->SetGuidance("Momentum of gamma quanta is stored in hits (default true).");
+
+  fCMDShard = new G4UIcmdWithAString("/jpetmc/output/shard", this);
+  fCMDShard->SetGuidance("Job is the shard i of N (format i/N, i = 0..N-1): events start at i * beamOn,");
+  fCMDShard->SetGuidance("output file is named after the shard; equivalent of --shard i/N in the command line");
+  fCMDShard->SetToBeBroadcasted(false);
 }
 
 EventMessenger::~EventMessenger()
@@ -92,10 +164,13 @@ EventMessenger::~EventMessenger()
   delete fPrintStat;
   delete fPrintStatPower;
   delete fPrintStatBar;
+  delete fCMDProgressInterval;
   delete fAddDatetime;
   delete fSetSeed;
   delete fSaveSeed;
   delete fCMDKillEventsEscapingWorld;
+  delete fCMDAcceptanceFilter;
+  delete fCMDAcceptanceFilterMode;
   delete fCMDMinRegMulti;
   delete fCMDMaxRegMulti;
   delete fCMDExcludedMulti;
@@ -104,6 +179,17 @@ EventMessenger::~EventMessenger()
   delete fCMDSave2g;
   delete fCMDSave3g;
   delete fCreateDecayTree;
+  delete fCMDAsyncWriter;
+  delete fCMDWriterQueueSize;
+  delete fCMDCompressionAlgorithm;
+  delete fCMDCompressionLevel;
+  delete fCMDBasketSize;
+  delete fCMDSplitLevel;
+  delete fCMDAutoFlush;
+  delete fCMDOutputBackend;
+  delete fCMDStorePolarization;
+  delete fCMDStoreMomentum;
+  delete fCMDShard;
 }
 
 void EventMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
@@ -112,20 +198,31 @@ void EventMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
     fPrintStatistics = fPrintStat->GetNewBoolValue(newValue);
   } else if (command == fPrintStatPower) {
     fPrintPower = fPrintStatPower->GetNewIntValue(newValue);
+    fPrintDivisor = static_cast<G4long>(std::pow(10, fPrintPower));
   } else if (command == fCMDMinRegMulti) {
     fMinRegisteredMultiplicity = fCMDMinRegMulti->GetNewIntValue(newValue);
   } else if (command == fCMDMaxRegMulti) {
     fMaxRegisteredMultiplicity = fCMDMaxRegMulti->GetNewIntValue(newValue);
   } else if (command == fPrintStatBar) {
     fShowProgress = fPrintStatBar->GetNewBoolValue(newValue);
+  } else if (command == fCMDProgressInterval) {
+    fProgressInterval = fCMDProgressInterval->GetNewDoubleValue(newValue);
   } else if (command == fAddDatetime) {
     fOutputWithDatetime = fAddDatetime->GetNewBoolValue(newValue);
   } else if (command == fCMDKillEventsEscapingWorld) {
     fKillEventsEscapingWorld = fCMDKillEventsEscapingWorld->GetNewBoolValue(newValue);
+  } else if (command == fCMDAcceptanceFilter) {
+    fUseAcceptanceFilter = fCMDAcceptanceFilter->GetNewBoolValue(newValue);
+  } else if (command == fCMDAcceptanceFilterMode) {
+    fApproximateAcceptanceFilter = (newValue == "approximate");
   } else if (command == fCMDExcludedMulti) {
     fExcludedMultiplicity = fCMDExcludedMulti->GetNewIntValue(newValue);
   } else if (command == fSetSeed) {
-    fSeed = fSetSeed->GetNewIntValue(newValue);
+    try {
+      fSeed = std::stol(newValue);
+    } catch (const std::exception&) {
+      G4Exception("EventMessenger", "EM01", JustWarning, "Seed has to be an integer number, value is not changed");
+    }
   } else if (command == fSaveSeed) {
     fSaveRandomSeed = fSaveSeed->GetNewBoolValue(newValue);
   } else if (command == fCMDAllowedMomentumTransfer) {
@@ -142,5 +239,75 @@ void EventMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
     fSave2g = fCMDSave2g->GetNewBoolValue(newValue);
   } else if (command == fCMDSave3g) {
     fSave3g = fCMDSave3g->GetNewBoolValue(newValue);
+  } else if (command == fCMDAsyncWriter) {
+    fUseAsyncWriter = fCMDAsyncWriter->GetNewBoolValue(newValue);
+  } else if (command == fCMDWriterQueueSize) {
+    fWriterQueueSize = fCMDWriterQueueSize->GetNewIntValue(newValue);
+  } else if (command == fCMDCompressionAlgorithm) {
+    fCompressionAlgorithm = newValue;
+  } else if (command == fCMDCompressionLevel) {
+    fCompressionLevel = fCMDCompressionLevel->GetNewIntValue(newValue);
+  } else if (command == fCMDBasketSize) {
+    fBasketSize = fCMDBasketSize->GetNewIntValue(newValue);
+  } else if (command == fCMDSplitLevel) {
+    fSplitLevel = fCMDSplitLevel->GetNewIntValue(newValue);
+  } else if (command == fCMDAutoFlush) {
+    fAutoFlush = fCMDAutoFlush->GetNewIntValue(newValue);
+  } else if (command == fCMDOutputBackend) {
+    fOutputBackend = newValue;
+  } else if (command == fCMDStorePolarization) {
+    fStorePolarization = fCMDStorePolarization->GetNewBoolValue(newValue);
+  } else if (command == fCMDStoreMomentum) {
+    fStoreMomentum = fCMDStoreMomentum->GetNewBoolValue(newValue);
+  } else if (command == fCMDShard) {
+    SetShard(newValue);
+  }
+}
+
+/**
+ * Algorithm codes follow ROOT::RCompressionSetting::EAlgorithm, default levels
+ * are the ones recommended by ROOT (zlib 1, lzma 7, lz4 4, zstd 5)
+ */
+G4int EventMessenger::GetCompressionSettings() const
+{
+  G4int algorithm = 0;
+  G4int level = 0;
+  if (fCompressionAlgorithm == "zlib") {
+    algorithm = 1;
+    level = 1;
+  } else if (fCompressionAlgorithm == "lzma") {
+    algorithm = 2;
+    level = 7;
+  } else if (fCompressionAlgorithm == "lz4") {
+    algorithm = 4;
+    level = 4;
+  } else if (fCompressionAlgorithm == "zstd") {
+    algorithm = 5;
+    level = 5;
+  } else if (fCompressionLevel < 0) {
+    return -1;
+  }
+  if (fCompressionLevel >= 0) level = fCompressionLevel;
+  return 100 * algorithm + level;
+}
+
+void EventMessenger::SetShard(const G4String& shard)
+{
+  std::size_t separator = shard.find('/');
+  G4int index = -1;
+  G4int count = 0;
+  try {
+    if (separator != std::string::npos) {
+      index = std::stoi(shard.substr(0, separator));
+      count = std::stoi(shard.substr(separator + 1));
+    }
+  } catch (const std::exception&) {
+    count = 0;
+  }
+  if (count < 1 || index < 0 || index >= count) {
+    G4Exception("EventMessenger", "EM02", FatalException, ("Shard has to be given as i/N with 0 <= i < N, got " + shard).c_str());
+    return;
   }
+  fShardIndex = index;
+  fShardCount = count;
 }
@@ -35,9 +35,15 @@ public:
   void SetNewValue(G4UIcommand*, G4String);
 
   bool KillEventsEscapingWorld() { return fKillEventsEscapingWorld; }
+  bool UseAcceptanceFilter() { return fUseAcceptanceFilter; }
+  //! Filter neglects scattering of the gamma quanta missing the barrel in the passive materials
+  bool IsAcceptanceFilterApproximate() { return fApproximateAcceptanceFilter; }
   bool PrintStatistics() { return fPrintStatistics; }
   bool ShowProgress() { return fShowProgress; }
   G4int GetPowerPrintStat() { return fPrintPower; }
+  //! Every 10^X-th event is printed, computed once when X is set
+  G4long GetPrintDivisor() { return fPrintDivisor; }
+  G4double GetProgressInterval() { return fProgressInterval; }
   bool AddDatetime() { return fOutputWithDatetime; }
   G4int GetMinRegMultiplicity() { return fMinRegisteredMultiplicity; }
   G4int GetMaxRegMultiplicity() { return fMaxRegisteredMultiplicity; }
@@ -47,27 +53,46 @@ public:
   G4double GetRangeCut() { return fRangeCut; }
   bool GetEnergyCutFlag() { return fUseEnergyCut; }
   bool GetRangeCutFlag() { return fUseRangeCut; }
-  G4int GetSeed() { return fSeed; }
+  G4long GetSeed() { return fSeed; }
   bool SaveSeed() { return fSaveRandomSeed; }
   bool Save2g() { return fSave2g; }
   bool Save3g() { return fSave3g; }
   bool GetCreateDecayTreeFlag() { return fCreateDecayTreeFlag; }
+  bool UseAsyncWriter() { return fUseAsyncWriter; }
+  G4int GetWriterQueueSize() { return fWriterQueueSize; }
+  //! ROOT compression settings (100 * algorithm + level), -1 for the ROOT default
+  G4int GetCompressionSettings() const;
+  G4int GetBasketSize() { return fBasketSize; }
+  G4int GetSplitLevel() { return fSplitLevel; }
+  G4int GetAutoFlush() { return fAutoFlush; }
+  bool UseRNTuple() { return fOutputBackend == "rntuple"; }
+  bool StorePolarization() { return fStorePolarization; }
+  bool StoreMomentum() { return fStoreMomentum; }
+  //! Job is the shard i of N of a campaign
+  bool IsSharded() { return fShardCount > 1; }
+  G4int GetShardIndex() { return fShardIndex; }
+  G4int GetShardCount() { return fShardCount; }
 
 private:
   static EventMessenger* fInstance;
   EventMessenger();
   ~EventMessenger();
+  void SetShard(const G4String& shard);
 
   G4UIdirectory* fDirectory = nullptr;
+  G4UIdirectory* fOutputDirectory = nullptr;
   G4UIcmdWithABool* fPrintStat = nullptr;
   G4UIcmdWithABool* fPrintStatBar = nullptr;
+  G4UIcmdWithADoubleAndUnit* fCMDProgressInterval = nullptr;
   G4UIcmdWithABool* fAddDatetime = nullptr;
   G4UIcmdWithABool* fCMDKillEventsEscapingWorld = nullptr;
+  G4UIcmdWithABool* fCMDAcceptanceFilter = nullptr;
+  G4UIcmdWithAString* fCMDAcceptanceFilterMode = nullptr;
   G4UIcmdWithAnInteger* fPrintStatPower = nullptr;
   G4UIcmdWithAnInteger* fCMDMinRegMulti = nullptr;
   G4UIcmdWithAnInteger* fCMDMaxRegMulti = nullptr;
   G4UIcmdWithAnInteger* fCMDExcludedMulti = nullptr;
-  G4UIcmdWithAnInteger* fSetSeed = nullptr;
+  G4UIcmdWithAString* fSetSeed = nullptr;
   G4UIcmdWithABool* fSaveSeed = nullptr;
   G4UIcmdWithADoubleAndUnit* fCMDAllowedMomentumTransfer = nullptr;
   G4UIcmdWithADoubleAndUnit* fCMDAppliedEnergyCut = nullptr;
@@ -75,16 +100,31 @@ private:
   G4UIcmdWithABool* fCMDSave2g = nullptr;
   G4UIcmdWithABool* fCMDSave3g = nullptr;
   G4UIcmdWithABool* fCreateDecayTree = nullptr;
+  G4UIcmdWithABool* fCMDAsyncWriter = nullptr;
+  G4UIcmdWithAnInteger* fCMDWriterQueueSize = nullptr;
+  G4UIcmdWithAString* fCMDCompressionAlgorithm = nullptr;
+  G4UIcmdWithAnInteger* fCMDCompressionLevel = nullptr;
+  G4UIcmdWithAnInteger* fCMDBasketSize = nullptr;
+  G4UIcmdWithAnInteger* fCMDSplitLevel = nullptr;
+  G4UIcmdWithAnInteger* fCMDAutoFlush = nullptr;
+  G4UIcmdWithAString* fCMDOutputBackend = nullptr;
+  G4UIcmdWithABool* fCMDStorePolarization = nullptr;
+  G4UIcmdWithABool* fCMDStoreMomentum = nullptr;
+  G4UIcmdWithAString* fCMDShard = nullptr;
   
   bool fPrintStatistics = false;
   G4int fPrintPower = 10;
+  G4long fPrintDivisor = 10000000000;
   bool fShowProgress = false;
+  G4double fProgressInterval = 10 * s;
   bool fOutputWithDatetime = false;
   bool fKillEventsEscapingWorld = false;
+  bool fUseAcceptanceFilter = false;
+  bool fApproximateAcceptanceFilter = false;
   G4int fMinRegisteredMultiplicity = 0;
   G4int fMaxRegisteredMultiplicity = 10;
   G4int fExcludedMultiplicity = 1;
-  G4int fSeed = 0;
+  G4long fSeed = 0;
   bool fSaveRandomSeed = false;
   G4double fAllowedMomentumTransfer = 1 * keV;
   bool fUseEnergyCut = false;
@@ -94,6 +134,20 @@ private:
   bool fSave2g = false;
   bool fSave3g = false;
   bool fCreateDecayTreeFlag = false;
+  bool fUseAsyncWriter = false;
+  G4int fWriterQueueSize = 8;
+  G4String fCompressionAlgorithm = "default";
+  //! -1 - level recommended for the chosen algorithm
+  G4int fCompressionLevel = -1;
+  G4int fBasketSize = 32000;
+  G4int fSplitLevel = 2;
+  //! ROOT default: flush baskets every 30 MB
+  G4int fAutoFlush = -30000000;
+  G4String fOutputBackend = "ttree";
+  bool fStorePolarization = true;
+  bool fStoreMomentum = true;
+  G4int fShardIndex = 0;
+  G4int fShardCount = 1;
 };
 
 #endif /* !EVENTMESSENGER_H */
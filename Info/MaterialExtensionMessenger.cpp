@@ -29,7 +29,8 @@ MaterialExtensionMessenger* MaterialExtensionMessenger::GetMaterialExtensionMess
 
 MaterialExtensionMessenger::MaterialExtensionMessenger()
 {
-  fDirectory = new G4UIdirectory("/jpetmc/material/");
+  //! Materials are shared by all threads - commands are not broadcasted to workers
+  fDirectory = new G4UIdirectory("/jpetmc/material/", false);
   fDirectory->SetGuidance("Commands for controling the geometry materials");
 
   f3GammaOnly = new G4UIcmdWithoutParameter("/jpetmc/material/threeGammaOnly", this);
@@ -93,6 +93,16 @@ PrimaryGeneratorActionMessenger::PrimaryGeneratorActionMessenger(PrimaryGenerato
   fSetChamberEffectivePositronRadius->SetDefaultValue(0.5);
   fSetChamberEffectivePositronRadius->SetDefaultUnit("cm");
   fSetChamberEffectivePositronRadius->SetUnitCandidates("cm");
+
+  fThreeGammaSampler = new G4UIcmdWithAString("/jpetmc/source/threeGammaSampler", this);
+  fThreeGammaSampler->SetGuidance("Sampling of 3g momenta: table (tabulated Dalitz plot, default) or phaseSpace (TGenPhaseSpace)");
+  fThreeGammaSampler->SetCandidates("table phaseSpace");
+  fThreeGammaSampler->SetDefaultValue("table");
+
+  fVertexSearch = new G4UIcmdWithAString("/jpetmc/run/vertexSearch", this);
+  fVertexSearch->SetGuidance("Search of the vertex along a ray in big chambers (RUN3,6,7,12): boundary (default) or fixedStep");
+  fVertexSearch->SetCandidates("boundary fixedStep");
+  fVertexSearch->SetDefaultValue("boundary");
 }
 
 PrimaryGeneratorActionMessenger::~PrimaryGeneratorActionMessenger()
@@ -108,6 +118,8 @@ PrimaryGeneratorActionMessenger::~PrimaryGeneratorActionMessenger()
   delete fNemaPosition;
   delete fSetChamberCenter;
   delete fSetChamberEffectivePositronRadius;
+  delete fThreeGammaSampler;
+  delete fVertexSearch;
 }
 
 void PrimaryGeneratorActionMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
@@ -149,6 +161,10 @@ void PrimaryGeneratorActionMessenger::SetNewValue(G4UIcommand* command, G4String
     fPrimGen->SetEffectivePositronRadius(
       fSetChamberEffectivePositronRadius->GetNewDoubleValue(newValue)
     );
+  } else if (command == fThreeGammaSampler) {
+    fPrimGen->SetThreeGammaTable(newValue == "table");
+  } else if (command == fVertexSearch) {
+    fPrimGen->SetBoundaryVertexSearch(newValue == "boundary");
   }
 }
 
@@ -57,6 +57,8 @@ private:
   G4UIcmdWithAnInteger* fNemaPosition = nullptr;
   G4UIcmdWith3VectorAndUnit* fSetChamberCenter = nullptr;
   G4UIcmdWithADoubleAndUnit* fSetChamberEffectivePositronRadius = nullptr;
+  G4UIcmdWithAString* fThreeGammaSampler = nullptr;
+  G4UIcmdWithAString* fVertexSearch = nullptr;
 };
 
 #endif /* !PRIMARYGENERATORACTIONMESSENGER_H */
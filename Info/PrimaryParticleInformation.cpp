@@ -15,8 +15,10 @@
 
 #include "PrimaryParticleInformation.h"
 
+G4ThreadLocal G4Allocator<PrimaryParticleInformation>* PrimaryParticleInformationAllocator = nullptr;
+
 PrimaryParticleInformation::PrimaryParticleInformation() :
-fIndex(0), fDecayMultiplicity(0), fGeneratedMultiplicity(0), fGenMomentum(0) {}
+fIndex(0), fDecayMultiplicity(0), fGeneratedMultiplicity(0), fGenMomentum(0), fRegistered(false) {}
 
 PrimaryParticleInformation::~PrimaryParticleInformation() {}
 
@@ -28,6 +30,7 @@ void PrimaryParticleInformation::Clear()
   fGenMomentum.setX(0);
   fGenMomentum.setY(0);
   fGenMomentum.setZ(0);
+  fRegistered = false;
 }
 
 void PrimaryParticleInformation::SetGenMomentum(G4double x, G4double y, G4double z)
@@ -18,6 +18,7 @@
 
 #include <G4VUserPrimaryParticleInformation.hh>
 #include <G4ThreeVector.hh>
+#include <G4Allocator.hh>
 #include <globals.hh>
 
 class PrimaryParticleInformation : public G4VUserPrimaryParticleInformation
@@ -25,6 +26,9 @@ class PrimaryParticleInformation : public G4VUserPrimaryParticleInformation
 public:
   PrimaryParticleInformation();
   virtual ~PrimaryParticleInformation();
+  //! Allocated from a thread local pool, every event creates new information objects
+  inline void* operator new(size_t);
+  inline void operator delete(void* info);
   void Clear();
   virtual void Print() const;
 
@@ -36,6 +40,9 @@ public:
   void SetGammaMultiplicity(G4int i) { fDecayMultiplicity = i; }
   void SetGenMomentum(G4double x, G4double y, G4double z);
   G4ThreeVector GenGenMomentum() { return fGenMomentum; }
+  //! Set when the gamma made its first hit with the generated multiplicity (see save2g/save3g)
+  void SetRegistered(G4bool tf) { fRegistered = tf; }
+  G4bool IsRegistered() { return fRegistered; }
 
   //! Multiplicity flags
   static const G4int kBackground = 0;
@@ -51,6 +58,22 @@ private:
   G4int fDecayMultiplicity;
   G4int fGeneratedMultiplicity;
   G4ThreeVector fGenMomentum;
+  G4bool fRegistered;
 };
 
+extern G4ThreadLocal G4Allocator<PrimaryParticleInformation>* PrimaryParticleInformationAllocator;
+
+inline void* PrimaryParticleInformation::operator new(size_t)
+{
+  if (!PrimaryParticleInformationAllocator) {
+    PrimaryParticleInformationAllocator = new G4Allocator<PrimaryParticleInformation>;
+  }
+  return (void*) PrimaryParticleInformationAllocator->MallocSingle();
+}
+
+inline void PrimaryParticleInformation::operator delete(void* info)
+{
+  PrimaryParticleInformationAllocator->FreeSingle((PrimaryParticleInformation*) info);
+}
+
 #endif /* !PRIMARY_PARTICLE_INFORMATION_H */
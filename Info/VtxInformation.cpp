@@ -15,6 +15,8 @@
 
 #include "VtxInformation.h"
 
+G4ThreadLocal G4Allocator<VtxInformation>* VtxInformationAllocator = nullptr;
+
 VtxInformation::VtxInformation() :
 fVtxPosition(0), fTwoGammaGen(false), fThreeGammaGen(false),
 fPromptGammaGen(false), fnRun(0), fLifetime(0) {}
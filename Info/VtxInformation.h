@@ -16,8 +16,9 @@
 #ifndef VTX_INFORMATION_H
 #define VTX_INFORMATION_H 1
 
-#include <G4ThreeVector.hh>
 #include <G4VUserPrimaryVertexInformation.hh>
+#include <G4ThreeVector.hh>
+#include <G4Allocator.hh>
 #include <globals.hh>
 
 class VtxInformation : public G4VUserPrimaryVertexInformation
@@ -25,6 +26,9 @@ class VtxInformation : public G4VUserPrimaryVertexInformation
 public:
   VtxInformation();
   virtual ~VtxInformation();
+  //! Allocated from a thread local pool, every event creates new information objects
+  inline void* operator new(size_t);
+  inline void operator delete(void* info);
   void Clear();
   virtual void Print() const;
 
@@ -52,4 +56,19 @@ private:
   G4double fLifetime;
 };
 
+extern G4ThreadLocal G4Allocator<VtxInformation>* VtxInformationAllocator;
+
+inline void* VtxInformation::operator new(size_t)
+{
+  if (!VtxInformationAllocator) {
+    VtxInformationAllocator = new G4Allocator<VtxInformation>;
+  }
+  return (void*) VtxInformationAllocator->MallocSingle();
+}
+
+inline void VtxInformation::operator delete(void* info)
+{
+  VtxInformationAllocator->FreeSingle((VtxInformation*) info);
+}
+
 #endif /* !VTX_INFORMATION_H */
@@ -15,40 +15,90 @@
 
 #include "Actions/ActionInitialization.h"
 #include "Core/DetectorConstruction.h"
+#include "Core/WorkerInitialization.h"
 #include "Info/EventMessenger.h"
 #include "Core/PhysicsList.h"
+#include "Core/EventSeeder.h"
 #include "Core/RunManager.h"
 
 #include <G4VisExecutive.hh>
 #include <G4UIExecutive.hh>
 #include <G4INCLRandom.hh>
 #include <G4UImanager.hh>
+#include <G4Threading.hh>
 #include <fstream>
 #include <random>
+#include <string>
+
+#ifdef G4MULTITHREADED
+#include <G4MTRunManager.hh>
+#include <TROOT.h>
+#endif
 
 int main (int argc, char** argv)
 {
   G4Random::setTheEngine(new CLHEP::MTwistEngine());
 
+  //! Usage: jpet_mc [-t|--threads N] [--shard i/N] [macro]
+  G4String macroName;
+  G4String shard;
+  G4int nThreads = 1;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if ((arg == "-t" || arg == "--threads") && i + 1 < argc) {
+      nThreads = std::stoi(argv[++i]);
+    } else if (arg == "--shard" && i + 1 < argc) {
+      shard = argv[++i];
+    } else {
+      macroName = arg;
+    }
+  }
+  if (nThreads <= 0) {
+    nThreads = G4Threading::G4GetNumberOfCores();
+  }
+
   G4UIExecutive* ui = 0;
-  if (argc == 1) {
+  if (macroName.empty()) {
     ui = new G4UIExecutive(argc, argv);
   }
 
-  RunManager* runManager = new RunManager;
+  G4RunManager* runManager = nullptr;
+#ifdef G4MULTITHREADED
+  if (nThreads > 1) {
+    //! ROOT output is created by every worker thread
+    ROOT::EnableThreadSafety();
+    G4MTRunManager* mtRunManager = new G4MTRunManager;
+    mtRunManager->SetNumberOfThreads(nThreads);
+    mtRunManager->SetUserInitialization(new WorkerInitialization);
+    runManager = mtRunManager;
+  } else {
+    runManager = new RunManager;
+  }
+#else
+  if (nThreads > 1) {
+    G4Exception(
+      "JPetMC", "MT01", JustWarning,
+      "Geant4 was built without multithreading support, running sequentially"
+    );
+  }
+  runManager = new RunManager;
+#endif
   runManager->SetUserInitialization(DetectorConstruction::GetInstance());
   runManager->SetUserInitialization(new PhysicsList);
   runManager->SetUserInitialization(new ActionInitialization);
 
   G4UImanager* UImanager = G4UImanager::GetUIpointer();
+  if (!shard.empty()) {
+    EventMessenger::GetEventMessenger();
+    UImanager->ApplyCommand("/jpetmc/output/shard " + shard);
+  }
   G4VisManager* visManager = new G4VisExecutive;
   visManager->Initialize();
 
   if (!ui) {
     //! batch mode
     G4String command = "/control/execute ";
-    G4String fileName = argv[1];
-    UImanager->ApplyCommand(command + fileName);
+    UImanager->ApplyCommand(command + macroName);
   } else {
     //! interactive mode
     UImanager->ApplyCommand("/control/execute init_vis.mac");
@@ -60,7 +110,7 @@ int main (int argc, char** argv)
   delete runManager;
 
   if (EventMessenger::GetEventMessenger()->SaveSeed()) {
-    long seed = G4Random::getTheSeed();
+    long seed = EventSeeder::GetRunSeed();
     std::ofstream file;
     file.open ("seed", std::ofstream::out | std::ofstream::app);
     file << seed << "\n";
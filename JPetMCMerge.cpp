@@ -0,0 +1,172 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetMCMerge.cpp
+ */
+
+#include <TFileMerger.h>
+#include <TTree.h>
+#include <TFile.h>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * Merges output files of the shards of a campaign (jpet_mc --shard i/N):
+ * trees are concatenated by copying the compressed baskets, histograms are added up.
+ * Event ranges written by the shards are checked before merging, so the same
+ * events can not be merged twice.
+ */
+
+struct ShardRange {
+  std::string fFileName;
+  int fShardIndex;
+  Long64_t fRunSeed;
+  Long64_t fFirstEvent;
+  Long64_t fNumberOfEvents;
+};
+
+//! Reads the ranges of the shards stored in the file; false if the file has no shard information
+bool readShardRanges(const std::string& fileName, std::vector<ShardRange>& ranges)
+{
+  TFile* file = TFile::Open(fileName.c_str(), "READ");
+  if (!file || file->IsZombie()) {
+    std::cerr << "Error: can not open " << fileName << std::endl;
+    delete file;
+    return false;
+  }
+  TTree* shards = dynamic_cast<TTree*>(file->Get("Shards"));
+  if (!shards) {
+    file->Close();
+    delete file;
+    return false;
+  }
+  Int_t shardIndex = 0;
+  Long64_t runSeed = 0, firstEvent = 0, numberOfEvents = 0;
+  shards->SetBranchAddress("shardIndex", &shardIndex);
+  shards->SetBranchAddress("runSeed", &runSeed);
+  shards->SetBranchAddress("firstEvent", &firstEvent);
+  shards->SetBranchAddress("numberOfEvents", &numberOfEvents);
+  for (Long64_t i = 0; i < shards->GetEntries(); i++) {
+    shards->GetEntry(i);
+    ranges.push_back({fileName, shardIndex, runSeed, firstEvent, numberOfEvents});
+  }
+  file->Close();
+  delete file;
+  return true;
+}
+
+//! Returns number of overlapping ranges
+int checkDuplicates(std::vector<ShardRange>& ranges)
+{
+  std::sort(ranges.begin(), ranges.end(), [](const ShardRange& a, const ShardRange& b) {
+    return a.fFirstEvent < b.fFirstEvent;
+  });
+  int duplicates = 0;
+  //! Range reaching furthest so far, a long range may overlap several ranges starting after it
+  std::size_t furthest = 0;
+  for (std::size_t i = 1; i < ranges.size(); i++) {
+    const ShardRange& previous = ranges[furthest];
+    const ShardRange& current = ranges[i];
+    if (current.fFirstEvent < previous.fFirstEvent + previous.fNumberOfEvents) {
+      std::cerr << "Error: events " << current.fFirstEvent << " - "
+        << std::min(current.fFirstEvent + current.fNumberOfEvents, previous.fFirstEvent + previous.fNumberOfEvents) - 1
+        << " are in " << previous.fFileName << " (shard " << previous.fShardIndex << ", seed " << previous.fRunSeed
+        << ") and " << current.fFileName << " (shard " << current.fShardIndex << ", seed " << current.fRunSeed
+        << ")" << std::endl;
+      duplicates++;
+    }
+    if (current.fFirstEvent + current.fNumberOfEvents > previous.fFirstEvent + previous.fNumberOfEvents) {
+      furthest = i;
+    }
+  }
+  return duplicates;
+}
+
+int main(int argc, char** argv)
+{
+  //! Usage: jpet_mc_merge [-f] output.root input.root ... | -l list_of_inputs.txt
+  bool force = false;
+  std::string outputName;
+  std::vector<std::string> inputNames;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "-f") {
+      force = true;
+    } else if (arg == "-l" && i + 1 < argc) {
+      std::ifstream list(argv[++i]);
+      std::string line;
+      while (std::getline(list, line)) {
+        if (!line.empty()) inputNames.push_back(line);
+      }
+    } else if (outputName.empty()) {
+      outputName = arg;
+    } else {
+      inputNames.push_back(arg);
+    }
+  }
+  if (outputName.empty() || inputNames.empty()) {
+    std::cerr << "Usage: jpet_mc_merge [-f] output.root input.root ... | -l list_of_inputs.txt" << std::endl;
+    std::cerr << "  -f  merge even if the same events are found in more than one input" << std::endl;
+    return 1;
+  }
+
+  std::vector<ShardRange> ranges;
+  for (const std::string& inputName : inputNames) {
+    if (!readShardRanges(inputName, ranges)) {
+      std::cerr << "Warning: no shard information in " << inputName << ", it is not checked for duplicates" << std::endl;
+    }
+  }
+  int duplicates = checkDuplicates(ranges);
+  if (duplicates > 0 && !force) {
+    std::cerr << duplicates << " duplicated event ranges found, nothing is merged (use -f to merge anyway)" << std::endl;
+    return 2;
+  }
+
+  //! Output keeps the compression of the inputs, otherwise baskets would be recompressed
+  int compression = -1;
+  TFile* first = TFile::Open(inputNames.front().c_str(), "READ");
+  if (first && !first->IsZombie()) {
+    compression = first->GetCompressionSettings();
+    first->Close();
+  }
+  delete first;
+
+  TFileMerger merger(kFALSE, kFALSE);
+  merger.SetFastMethod(kTRUE);
+  merger.SetPrintLevel(0);
+  bool opened = compression >= 0
+    ? merger.OutputFile(outputName.c_str(), "RECREATE", compression)
+    : merger.OutputFile(outputName.c_str(), "RECREATE");
+  if (!opened) {
+    std::cerr << "Error: can not create " << outputName << std::endl;
+    return 1;
+  }
+  for (const std::string& inputName : inputNames) {
+    if (!merger.AddFile(inputName.c_str(), kFALSE)) {
+      std::cerr << "Error: can not add " << inputName << std::endl;
+      return 1;
+    }
+  }
+  if (!merger.Merge()) {
+    std::cerr << "Error: merging failed" << std::endl;
+    return 1;
+  }
+
+  Long64_t events = 0;
+  for (const ShardRange& range : ranges) events += range.fNumberOfEvents;
+  std::cout << "Merged " << inputNames.size() << " files (" << ranges.size() << " shards, "
+    << events << " generated events) into " << outputName << std::endl;
+  return 0;
+}
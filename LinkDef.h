@@ -6,4 +6,29 @@
 #pragma link C++ class JPetGeantEventInformation+;
 #pragma link C++ class EvtInfo+;
 
+//! Versions 1-2 of JPetGeantScinHits kept TVector3 members, version 3 stores float components
+#pragma read sourceClass="JPetGeantScinHits" targetClass="JPetGeantScinHits" version="[1-2]" \
+  source="TVector3 fPosition" target="fPosX, fPosY, fPosZ" \
+  code="{ fPosX = onfile.fPosition.X(); fPosY = onfile.fPosition.Y(); fPosZ = onfile.fPosition.Z(); }"
+#pragma read sourceClass="JPetGeantScinHits" targetClass="JPetGeantScinHits" version="[1-2]" \
+  source="TVector3 fPolarizationIn" target="fPolInX, fPolInY, fPolInZ" \
+  code="{ fPolInX = onfile.fPolarizationIn.X(); fPolInY = onfile.fPolarizationIn.Y(); fPolInZ = onfile.fPolarizationIn.Z(); }"
+#pragma read sourceClass="JPetGeantScinHits" targetClass="JPetGeantScinHits" version="[1-2]" \
+  source="TVector3 fPolarizationOut" target="fPolOutX, fPolOutY, fPolOutZ" \
+  code="{ fPolOutX = onfile.fPolarizationOut.X(); fPolOutY = onfile.fPolarizationOut.Y(); fPolOutZ = onfile.fPolarizationOut.Z(); }"
+#pragma read sourceClass="JPetGeantScinHits" targetClass="JPetGeantScinHits" version="[1-2]" \
+  source="TVector3 fMomentumIn" target="fMomInX, fMomInY, fMomInZ" \
+  code="{ fMomInX = onfile.fMomentumIn.X(); fMomInY = onfile.fMomentumIn.Y(); fMomInZ = onfile.fMomentumIn.Z(); }"
+#pragma read sourceClass="JPetGeantScinHits" targetClass="JPetGeantScinHits" version="[1-2]" \
+  source="TVector3 fMomentumOut" target="fMomOutX, fMomOutY, fMomOutZ" \
+  code="{ fMomOutX = onfile.fMomentumOut.X(); fMomOutY = onfile.fMomentumOut.Y(); fMomOutZ = onfile.fMomentumOut.Z(); }"
+//! Event IDs are 64 bit since version 4 of JPetGeantEventPack and JPetGeantScinHits
+#pragma read sourceClass="JPetGeantEventPack" targetClass="JPetGeantEventPack" version="[1-3]" \
+  source="unsigned int fEvtIndex" target="fEvtIndex" code="{ fEvtIndex = onfile.fEvtIndex; }"
+#pragma read sourceClass="JPetGeantScinHits" targetClass="JPetGeantScinHits" version="[1-3]" \
+  source="int fEvtID" target="fEvtID" code="{ fEvtID = onfile.fEvtID; }"
+#ifdef JPETMC_WITH_RNTUPLE
+#pragma link C++ class JPetGeantNTupleReader;
+#endif
+
 #endif
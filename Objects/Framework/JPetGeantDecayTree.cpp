@@ -99,6 +99,12 @@ void JPetGeantDecayTree::AddNodeToBranch(int nodeID, int trackID, InteractionTyp
   }
 }
 
+void JPetGeantDecayTree::AddBranch(const Branch& branch)
+{
+  fTrackBranchConnection.insert(std::make_pair(branch.fTrackID, fBranches.size()));
+  fBranches.push_back(branch);
+}
+
 // cppcheck-suppress unusedFunction
 Branch JPetGeantDecayTree::GetBranch(unsigned trackID) const
 {
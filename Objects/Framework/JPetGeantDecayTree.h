@@ -67,6 +67,9 @@ public:
   int FindPrimaryPhoton(int nodeID);
   void AddNodeToBranch(int nodeID, int trackID, InteractionType interactionType);
   Branch GetBranch(unsigned trackID) const;
+  const std::vector<Branch>& GetBranches() const { return fBranches; };
+  //! Adds complete branch, used when reading the columnar output
+  void AddBranch(const Branch& branch);
 
 private:
   std::vector<Branch> fBranches;
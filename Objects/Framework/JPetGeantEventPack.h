@@ -50,18 +50,19 @@ public:
   JPetGeantEventInformation* GetEventInformation() { return fGenInfo; };
   unsigned int GetNumberOfHits() { return fHitIndex; };
   unsigned int GetNumberOfDecayTrees() { return fMCDecayTreesIndex; };
-  unsigned int GetEventNumber() { return fEvtIndex; };
-  void SetEventNumber(int x) { fEvtIndex = x; };
+  //! Global event ID, shards of a campaign of thousands of jobs exceed 32 bits
+  Long64_t GetEventNumber() { return fEvtIndex; };
+  void SetEventNumber(Long64_t x) { fEvtIndex = x; };
 
 private:
   TClonesArray fMCHits;
   TClonesArray fMCDecayTrees;
   JPetGeantEventInformation* fGenInfo;
-  unsigned int fEvtIndex;
+  Long64_t fEvtIndex;
   unsigned int fHitIndex;
   unsigned int fMCDecayTreesIndex;
 
-  ClassDef(JPetGeantEventPack, 3)
+  ClassDef(JPetGeantEventPack, 4)
 };
 
 #endif /* !JPETGEANTEVENTPACK_H */
@@ -0,0 +1,240 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetGeantNTuple.cpp
+ */
+
+#ifdef JPETMC_WITH_RNTUPLE
+
+#include "JPetGeantNTuple.h"
+#include <type_traits>
+#include <stdexcept>
+#include <exception>
+#include <string>
+
+namespace
+{
+  //! Size of the generated gamma momenta in JPetGeantEventInformation
+  const unsigned int kGenGammaMomenta = 4;
+
+  template <typename T>
+  void clearColumn(std::vector<T>& column) { column.clear(); }
+
+  //! Single value columns are overwritten for each event
+  template <typename T>
+  void clearColumn(T&) {}
+}
+
+template <typename Function>
+void JPetGeantNTupleColumns::ForEachColumn(Function function)
+{
+  function("eventNumber", fEventNumber);
+  function("runNr", fRunNr);
+  function("genGammaFlags", fGenGammaFlags);
+  function("vtxX", fVtxX);
+  function("vtxY", fVtxY);
+  function("vtxZ", fVtxZ);
+  function("vtxPromptX", fVtxPromptX);
+  function("vtxPromptY", fVtxPromptY);
+  function("vtxPromptZ", fVtxPromptZ);
+  function("lifetime", fLifetime);
+  function("promptLifetime", fPromptLifetime);
+  function("genMomentumX", fGenMomentumX);
+  function("genMomentumY", fGenMomentumY);
+  function("genMomentumZ", fGenMomentumZ);
+  function("hitScinID", fHitScinID);
+  function("hitTrackID", fHitTrackID);
+  function("hitTrackPDG", fHitTrackPDG);
+  function("hitNumOfInteractions", fHitNumOfInteractions);
+  function("hitGenGammaIndex", fHitGenGammaIndex);
+  function("hitGenGammaMultiplicity", fHitGenGammaMultiplicity);
+  function("hitEneDep", fHitEneDep);
+  function("hitTime", fHitTime);
+  function("hitPosX", fHitPosX);
+  function("hitPosY", fHitPosY);
+  function("hitPosZ", fHitPosZ);
+  function("hitPolInX", fHitPolInX);
+  function("hitPolInY", fHitPolInY);
+  function("hitPolInZ", fHitPolInZ);
+  function("hitPolOutX", fHitPolOutX);
+  function("hitPolOutY", fHitPolOutY);
+  function("hitPolOutZ", fHitPolOutZ);
+  function("hitMomInX", fHitMomInX);
+  function("hitMomInY", fHitMomInY);
+  function("hitMomInZ", fHitMomInZ);
+  function("hitMomOutX", fHitMomOutX);
+  function("hitMomOutY", fHitMomOutY);
+  function("hitMomOutZ", fHitMomOutZ);
+  function("decayTreeNumOfBranches", fDecayTreeNumOfBranches);
+  function("branchTrackID", fBranchTrackID);
+  function("branchPrimaryID", fBranchPrimaryID);
+  function("branchNodeIDs", fBranchNodeIDs);
+  function("branchInteractionTypes", fBranchInteractionTypes);
+}
+
+void JPetGeantNTupleColumns::Create(RNTupleAPI::RNTupleModel& model, bool storePolarization, bool storeMomentum)
+{
+  ForEachColumn([&](const char* name, auto& column) {
+    using Type = typename std::decay_t<decltype(column)>::element_type;
+    std::string columnName(name);
+    if (!storePolarization && columnName.compare(0, 6, "hitPol") == 0) return;
+    if (!storeMomentum && columnName.compare(0, 6, "hitMom") == 0) return;
+    column = model.MakeField<Type>(name);
+  });
+}
+
+void JPetGeantNTupleColumns::Connect(RNTupleAPI::REntry& entry)
+{
+  ForEachColumn([&entry](const char* name, auto& column) {
+    using Type = typename std::decay_t<decltype(column)>::element_type;
+    std::string columnName(name);
+    bool optional = columnName.compare(0, 6, "hitPol") == 0 || columnName.compare(0, 6, "hitMom") == 0;
+    try {
+      column = entry.GetPtr<Type>(name);
+    } catch (const std::exception& error) {
+      if (!optional) {
+        throw std::runtime_error("Column " + columnName + " missing in the RNTuple: " + error.what());
+      }
+      column.reset();
+    }
+  });
+}
+
+void JPetGeantNTupleColumns::FromEventPack(JPetGeantEventPack& pack)
+{
+  ForEachColumn([](const char*, auto& column) {
+    if (column) clearColumn(*column);
+  });
+  *fEventNumber = pack.GetEventNumber();
+
+  JPetGeantEventInformation* info = pack.GetEventInformation();
+  *fRunNr = info->GetRunNr();
+  *fGenGammaFlags = (info->GetPromptGammaGen() ? 1 : 0)
+    | (info->GetTwoGammaGen() ? 2 : 0) | (info->GetThreeGammaGen() ? 4 : 0);
+  *fVtxX = info->GetVtxPositionX();
+  *fVtxY = info->GetVtxPositionY();
+  *fVtxZ = info->GetVtxPositionZ();
+  *fVtxPromptX = info->GetVtxPromptPositionX();
+  *fVtxPromptY = info->GetVtxPromptPositionY();
+  *fVtxPromptZ = info->GetVtxPromptPositionZ();
+  *fLifetime = info->GetLifetime();
+  *fPromptLifetime = info->GetPromptLifetime();
+  for (unsigned int i = 0; i < kGenGammaMomenta; i++) {
+    TVector3 momentum = info->GetMomentumGamma(i);
+    fGenMomentumX->push_back(momentum.X());
+    fGenMomentumY->push_back(momentum.Y());
+    fGenMomentumZ->push_back(momentum.Z());
+  }
+
+  for (unsigned int i = 0; i < pack.GetNumberOfHits(); i++) {
+    JPetGeantScinHits* hit = pack.GetHit(i);
+    fHitScinID->push_back(hit->GetScinID());
+    fHitTrackID->push_back(hit->GetTrackID());
+    fHitTrackPDG->push_back(hit->GetTrackPDG());
+    fHitNumOfInteractions->push_back(hit->GetNumOfInteractions());
+    fHitGenGammaIndex->push_back(hit->GetGenGammaIndex());
+    fHitGenGammaMultiplicity->push_back(hit->GetGenGammaMultiplicity());
+    fHitEneDep->push_back(hit->GetEneDepos());
+    fHitTime->push_back(hit->GetTime());
+    fHitPosX->push_back(hit->GetHitPositionX());
+    fHitPosY->push_back(hit->GetHitPositionY());
+    fHitPosZ->push_back(hit->GetHitPositionZ());
+    if (fHitPolInX) {
+      fHitPolInX->push_back(hit->GetPolarizationInX());
+      fHitPolInY->push_back(hit->GetPolarizationInY());
+      fHitPolInZ->push_back(hit->GetPolarizationInZ());
+      fHitPolOutX->push_back(hit->GetPolarizationOutX());
+      fHitPolOutY->push_back(hit->GetPolarizationOutY());
+      fHitPolOutZ->push_back(hit->GetPolarizationOutZ());
+    }
+    if (fHitMomInX) {
+      fHitMomInX->push_back(hit->GetMomentumInX());
+      fHitMomInY->push_back(hit->GetMomentumInY());
+      fHitMomInZ->push_back(hit->GetMomentumInZ());
+      fHitMomOutX->push_back(hit->GetMomentumOutX());
+      fHitMomOutY->push_back(hit->GetMomentumOutY());
+      fHitMomOutZ->push_back(hit->GetMomentumOutZ());
+    }
+  }
+
+  for (unsigned int i = 0; i < pack.GetNumberOfDecayTrees(); i++) {
+    const std::vector<Branch>& branches = pack.GetDecayTree(i)->GetBranches();
+    fDecayTreeNumOfBranches->push_back(branches.size());
+    for (const Branch& branch : branches) {
+      fBranchTrackID->push_back(branch.fTrackID);
+      fBranchPrimaryID->push_back(branch.fPrimaryBranchID);
+      fBranchNodeIDs->push_back(branch.fNodeIDs);
+      fBranchInteractionTypes->emplace_back(branch.fInteractionType.begin(), branch.fInteractionType.end());
+    }
+  }
+}
+
+void JPetGeantNTupleColumns::ToEventPack(JPetGeantEventPack& pack) const
+{
+  pack.Clear();
+  pack.SetEventNumber(*fEventNumber);
+
+  JPetGeantEventInformation* info = pack.GetEventInformation();
+  info->SetRunNr(*fRunNr);
+  info->SetPromptGammaGen(*fGenGammaFlags & 1);
+  info->SetTwoGammaGen(*fGenGammaFlags & 2);
+  info->SetThreeGammaGen(*fGenGammaFlags & 4);
+  info->SetVtxPosition(*fVtxX, *fVtxY, *fVtxZ);
+  info->SetVtxPromptPosition(*fVtxPromptX, *fVtxPromptY, *fVtxPromptZ);
+  info->SetLifetime(*fLifetime);
+  info->SetPromptLifetime(*fPromptLifetime);
+  for (unsigned int i = 0; i < fGenMomentumX->size() && i < kGenGammaMomenta; i++) {
+    info->SetMomentumGamma(i, (*fGenMomentumX)[i], (*fGenMomentumY)[i], (*fGenMomentumZ)[i]);
+  }
+
+  for (unsigned int i = 0; i < fHitScinID->size(); i++) {
+    JPetGeantScinHits* hit = pack.ConstructNextHit();
+    hit->Fill(
+      *fEventNumber, (*fHitScinID)[i], (*fHitTrackID)[i], (*fHitTrackPDG)[i],
+      (*fHitNumOfInteractions)[i], (*fHitEneDep)[i], (*fHitTime)[i]
+    );
+    hit->SetGenGammaIndex((*fHitGenGammaIndex)[i]);
+    hit->SetGenGammaMultiplicity((*fHitGenGammaMultiplicity)[i]);
+    hit->SetHitPosition((*fHitPosX)[i], (*fHitPosY)[i], (*fHitPosZ)[i]);
+    if (fHitPolInX) {
+      hit->SetPolarizationIn((*fHitPolInX)[i], (*fHitPolInY)[i], (*fHitPolInZ)[i]);
+      hit->SetPolarizationOut((*fHitPolOutX)[i], (*fHitPolOutY)[i], (*fHitPolOutZ)[i]);
+    } else {
+      hit->SetPolarizationIn(0.0f, 0.0f, 0.0f);
+      hit->SetPolarizationOut(0.0f, 0.0f, 0.0f);
+    }
+    if (fHitMomInX) {
+      hit->SetMomentumIn((*fHitMomInX)[i], (*fHitMomInY)[i], (*fHitMomInZ)[i]);
+      hit->SetMomentumOut((*fHitMomOutX)[i], (*fHitMomOutY)[i], (*fHitMomOutZ)[i]);
+    } else {
+      hit->SetMomentumIn(0.0f, 0.0f, 0.0f);
+      hit->SetMomentumOut(0.0f, 0.0f, 0.0f);
+    }
+  }
+
+  unsigned int branchIndex = 0;
+  for (int numOfBranches : *fDecayTreeNumOfBranches) {
+    JPetGeantDecayTree* decayTree = pack.ConstructNextDecayTree();
+    decayTree->Clean();
+    for (int i = 0; i < numOfBranches; i++, branchIndex++) {
+      Branch branch((*fBranchTrackID)[branchIndex], (*fBranchPrimaryID)[branchIndex]);
+      const std::vector<int>& nodeIDs = (*fBranchNodeIDs)[branchIndex];
+      const std::vector<int>& interactionTypes = (*fBranchInteractionTypes)[branchIndex];
+      for (unsigned int node = 0; node < nodeIDs.size(); node++) {
+        branch.AddNodeID(nodeIDs[node], static_cast<InteractionType>(interactionTypes[node]));
+      }
+      decayTree->AddBranch(branch);
+    }
+  }
+}
+
+#endif /* JPETMC_WITH_RNTUPLE */
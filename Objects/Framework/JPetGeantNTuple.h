@@ -0,0 +1,86 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetGeantNTuple.h
+ */
+
+#ifndef JPETGEANTNTUPLE_H
+#define JPETGEANTNTUPLE_H 1
+
+#include "JPetGeantEventPack.h"
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/REntry.hxx>
+#include <RVersion.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+//! RNTuple classes left the experimental namespace in ROOT 6.36
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 36, 0)
+namespace RNTupleAPI = ROOT;
+#else
+namespace RNTupleAPI = ROOT::Experimental;
+#endif
+
+/**
+ * @class JPetGeantNTupleColumns
+ * @brief columns of the RNTuple output; the same content as JPetGeantEventPack
+ * stored as plain numbers and vectors of numbers, one entry per event
+ */
+class JPetGeantNTupleColumns
+{
+public:
+  //! Creates columns in the model used for writing, polarization and momentum of hits are optional
+  void Create(RNTupleAPI::RNTupleModel& model, bool storePolarization = true, bool storeMomentum = true);
+  //! Connects to the columns of the entry used for reading; missing optional columns (polarization, momentum)
+  //! are left empty, a missing mandatory column throws std::runtime_error with its name
+  void Connect(RNTupleAPI::REntry& entry);
+  void FromEventPack(JPetGeantEventPack& pack);
+  void ToEventPack(JPetGeantEventPack& pack) const;
+
+private:
+  template <typename Function>
+  void ForEachColumn(Function function);
+
+  std::shared_ptr<std::int64_t> fEventNumber;
+  std::shared_ptr<int> fRunNr;
+  //! bit 0 - prompt; 1 - back-to-back; 2 - oPs, as in JPetGeantEventInformation
+  std::shared_ptr<std::uint8_t> fGenGammaFlags;
+  std::shared_ptr<double> fVtxX, fVtxY, fVtxZ;
+  std::shared_ptr<double> fVtxPromptX, fVtxPromptY, fVtxPromptZ;
+  std::shared_ptr<double> fLifetime;
+  std::shared_ptr<double> fPromptLifetime;
+  std::shared_ptr<std::vector<double>> fGenMomentumX, fGenMomentumY, fGenMomentumZ;
+
+  std::shared_ptr<std::vector<int>> fHitScinID;
+  std::shared_ptr<std::vector<int>> fHitTrackID;
+  std::shared_ptr<std::vector<int>> fHitTrackPDG;
+  std::shared_ptr<std::vector<int>> fHitNumOfInteractions;
+  std::shared_ptr<std::vector<int>> fHitGenGammaIndex;
+  std::shared_ptr<std::vector<int>> fHitGenGammaMultiplicity;
+  std::shared_ptr<std::vector<float>> fHitEneDep;
+  std::shared_ptr<std::vector<float>> fHitTime;
+  std::shared_ptr<std::vector<float>> fHitPosX, fHitPosY, fHitPosZ;
+  std::shared_ptr<std::vector<float>> fHitPolInX, fHitPolInY, fHitPolInZ;
+  std::shared_ptr<std::vector<float>> fHitPolOutX, fHitPolOutY, fHitPolOutZ;
+  std::shared_ptr<std::vector<float>> fHitMomInX, fHitMomInY, fHitMomInZ;
+  std::shared_ptr<std::vector<float>> fHitMomOutX, fHitMomOutY, fHitMomOutZ;
+
+  //! Decay trees are flattened into their branches
+  std::shared_ptr<std::vector<int>> fDecayTreeNumOfBranches;
+  std::shared_ptr<std::vector<int>> fBranchTrackID;
+  std::shared_ptr<std::vector<int>> fBranchPrimaryID;
+  std::shared_ptr<std::vector<std::vector<int>>> fBranchNodeIDs;
+  std::shared_ptr<std::vector<std::vector<int>>> fBranchInteractionTypes;
+};
+
+#endif /* !JPETGEANTNTUPLE_H */
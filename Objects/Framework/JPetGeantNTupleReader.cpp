@@ -0,0 +1,40 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetGeantNTupleReader.cpp
+ */
+
+#ifdef JPETMC_WITH_RNTUPLE
+
+#include "JPetGeantNTupleReader.h"
+
+JPetGeantNTupleReader::JPetGeantNTupleReader(const std::string& fileName, const std::string& ntupleName)
+{
+  fReader = RNTupleAPI::RNTupleReader::Open(ntupleName, fileName);
+  fEntry = fReader->GetModel().CreateEntry();
+  fColumns.Connect(*fEntry);
+}
+
+JPetGeantNTupleReader::~JPetGeantNTupleReader() {}
+
+unsigned long long JPetGeantNTupleReader::GetEntries() const
+{
+  return fReader->GetNEntries();
+}
+
+void JPetGeantNTupleReader::ReadEvent(unsigned long long entry, JPetGeantEventPack& pack)
+{
+  fReader->LoadEntry(entry, *fEntry);
+  fColumns.ToEventPack(pack);
+}
+
+#endif /* JPETMC_WITH_RNTUPLE */
@@ -0,0 +1,49 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Monte Carlo Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetGeantNTupleReader.h
+ */
+
+#ifndef JPETGEANTNTUPLEREADER_H
+#define JPETGEANTNTUPLEREADER_H 1
+
+#include "JPetGeantEventPack.h"
+#include "JPetGeantNTuple.h"
+#include <ROOT/RNTupleReader.hxx>
+#include <memory>
+#include <string>
+
+/**
+ * @class JPetGeantNTupleReader
+ * @brief reads the RNTuple output of the simulation;
+ * events are loaded into JPetGeantEventPack, so the analysis code does not change,
+ * or single columns are read directly with views of the underlying reader
+ */
+class JPetGeantNTupleReader
+{
+public:
+  explicit JPetGeantNTupleReader(const std::string& fileName, const std::string& ntupleName = "T");
+  ~JPetGeantNTupleReader();
+
+  unsigned long long GetEntries() const;
+  //! Fills the event pack with the content of the entry
+  void ReadEvent(unsigned long long entry, JPetGeantEventPack& pack);
+  //! e.g. GetReader().GetView<std::vector<float>>("hitEneDep") for columnar reads
+  RNTupleAPI::RNTupleReader& GetReader() { return *fReader; };
+
+private:
+  std::unique_ptr<RNTupleAPI::RNTupleReader> fReader; //!
+  std::unique_ptr<RNTupleAPI::REntry> fEntry; //!
+  JPetGeantNTupleColumns fColumns; //!
+};
+
+#endif /* !JPETGEANTNTUPLEREADER_H */
@@ -20,26 +20,33 @@ ClassImp(JPetGeantScinHits)
 JPetGeantScinHits::JPetGeantScinHits() :
 TObject(), fEvtID(0), fScinID(0), fTrackID(0), fTrackPDGencoding(0),
 fNumOfInteractions(0), fGenGammaIndex(0), fGenGammaMultiplicity(0), fEneDep(0),
-fTime(0), fPosition(0, 0, 0), fPolarizationIn(0, 0, 0),
-fPolarizationOut(0, 0, 0), fMomentumIn(0, 0, 0), fMomentumOut(0, 0, 0) {}
+fTime(0) {}
 
 JPetGeantScinHits::JPetGeantScinHits(
-  int evID, int scinID, int trkID, int trkPDG, int nInter, float ene, float time, TVector3 hit
+  Long64_t evID, int scinID, int trkID, int trkPDG, int nInter, float ene, float time, TVector3 hit
 ) : TObject(), fEvtID(evID), fScinID(scinID), fTrackID(trkID), fTrackPDGencoding(trkPDG),
 fNumOfInteractions(nInter), fGenGammaIndex(0), fGenGammaMultiplicity(0),
-fEneDep(ene), fTime(time), fPosition(hit), fPolarizationIn(0, 0, 0),
-fPolarizationOut(0, 0, 0), fMomentumIn(0, 0, 0), fMomentumOut(0, 0, 0) {}
+fEneDep(ene), fTime(time)
+{
+  SetHitPosition(hit);
+}
 
 JPetGeantScinHits::JPetGeantScinHits(
-  int evID, int scinID, int trkID, int trkPDG, int nInter, float ene, float time,
+  Long64_t evID, int scinID, int trkID, int trkPDG, int nInter, float ene, float time,
   TVector3 hit, TVector3 polIn, TVector3 polOut, TVector3 momeIn, TVector3 momeOut) :
 TObject(), fEvtID(evID), fScinID(scinID), fTrackID(trkID), fTrackPDGencoding(trkPDG),
 fNumOfInteractions(nInter), fGenGammaIndex(0), fGenGammaMultiplicity(0),
-fEneDep(ene), fTime(time), fPosition(hit), fPolarizationIn(polIn),
-fPolarizationOut(polOut), fMomentumIn(momeIn), fMomentumOut(momeOut) {}
+fEneDep(ene), fTime(time)
+{
+  SetHitPosition(hit);
+  SetPolarizationIn(polIn);
+  SetPolarizationOut(polOut);
+  SetMomentumIn(momeIn);
+  SetMomentumOut(momeOut);
+}
 
 void JPetGeantScinHits::Fill(
-  int evID, int scinID, int trkID, int trkPDG, int nInter, float ene, float time
+  Long64_t evID, int scinID, int trkID, int trkPDG, int nInter, float ene, float time
 ) {
   this->SetEvtID(evID);
   this->SetScinID(scinID);
@@ -51,7 +58,7 @@ void JPetGeantScinHits::Fill(
 }
 
 void JPetGeantScinHits::Fill(
-  int evID, int scinID, int trkID, int trkPDG, int nInter, float ene, float time,
+  Long64_t evID, int scinID, int trkID, int trkPDG, int nInter, float ene, float time,
   TVector3 hit, TVector3 polIn, TVector3 polOut, TVector3 momeIn, TVector3 momeOut
 ) {
   this->SetEvtID(evID);
@@ -79,9 +86,9 @@ void JPetGeantScinHits::Clean()
   this->SetNumOfInteractions(0);
   this->SetEneDepos(0.0);
   this->SetTime(0.0);
-  this->SetHitPosition(TVector3());
-  this->SetPolarizationIn(TVector3());
-  this->SetPolarizationOut(TVector3());
-  this->SetMomentumIn(TVector3());
-  this->SetMomentumOut(TVector3());
+  this->SetHitPosition(0.0f, 0.0f, 0.0f);
+  this->SetPolarizationIn(0.0f, 0.0f, 0.0f);
+  this->SetPolarizationOut(0.0f, 0.0f, 0.0f);
+  this->SetMomentumIn(0.0f, 0.0f, 0.0f);
+  this->SetMomentumOut(0.0f, 0.0f, 0.0f);
 }
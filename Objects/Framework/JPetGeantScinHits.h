@@ -29,60 +29,76 @@ class JPetGeantScinHits : public TObject
 public:
   JPetGeantScinHits();
   JPetGeantScinHits(
-    int evID, int scinID, int trkID, int trkPDG, int nInter,
+    Long64_t evID, int scinID, int trkID, int trkPDG, int nInter,
     float ene, float time, TVector3 hit
   );
   JPetGeantScinHits(
-    int evID, int scinID, int trkID, int trkPDG, int nInter,
+    Long64_t evID, int scinID, int trkID, int trkPDG, int nInter,
     float ene, float time, TVector3 hit, TVector3 polIn,
     TVector3 polOut, TVector3 momeIn, TVector3 momeOut
   );
   ~JPetGeantScinHits();
 
   void Fill(
-    int evID, int scinID, int trkID, int trkPDG, int nInter, float ene, float time
+    Long64_t evID, int scinID, int trkID, int trkPDG, int nInter, float ene, float time
   );
   void Fill(
-    int evID, int scinID, int trkID, int trkPDG, int nInter, float ene, float time,
+    Long64_t evID, int scinID, int trkID, int trkPDG, int nInter, float ene, float time,
     TVector3 hit, TVector3 polIn, TVector3 polOut, TVector3 momeIn, TVector3 momeOut
   );
   void Clean();
-  void SetEvtID(int x) { fEvtID = x; };
+  void SetEvtID(Long64_t x) { fEvtID = x; };
   void SetScinID(int x) { fScinID = x; };
   void SetTrackID(int x) { fTrackID = x; };
   void SetTrackPDG(int x) { fTrackPDGencoding = x; };
   void SetNumOfInteractions(int x) { fNumOfInteractions = x; };
   void SetEneDepos(float x) { fEneDep = x; };
   void SetTime(float x) { fTime = x; };
-  void SetHitPosition(TVector3 x) { fPosition = x; };
-  void SetHitPosition(float x, float y, float z) { fPosition.SetXYZ(x, y, z); };
-  void SetPolarizationIn(TVector3 x) { fPolarizationIn = x; };
-  void SetPolarizationIn(float x, float y, float z) { fPolarizationIn.SetXYZ(x, y, z); };
-  void SetPolarizationOut(TVector3 x) { fPolarizationOut = x; };
-  void SetPolarizationOut(float x, float y, float z) { fPolarizationOut.SetXYZ(x, y, z); };
-  void SetMomentumIn(TVector3 x) { fMomentumIn = x; };
-  void SetMomentumIn(float x, float y, float z) { fMomentumIn.SetXYZ(x, y, z); };
-  void SetMomentumOut(TVector3 x) { fMomentumOut = x; };
-  void SetMomentumOut(float x, float y, float z) { fMomentumOut.SetXYZ(x, y, z); };
+  void SetHitPosition(const TVector3& x) { SetHitPosition(x.X(), x.Y(), x.Z()); };
+  void SetHitPosition(float x, float y, float z) { fPosX = x; fPosY = y; fPosZ = z; };
+  void SetPolarizationIn(const TVector3& x) { SetPolarizationIn(x.X(), x.Y(), x.Z()); };
+  void SetPolarizationIn(float x, float y, float z) { fPolInX = x; fPolInY = y; fPolInZ = z; };
+  void SetPolarizationOut(const TVector3& x) { SetPolarizationOut(x.X(), x.Y(), x.Z()); };
+  void SetPolarizationOut(float x, float y, float z) { fPolOutX = x; fPolOutY = y; fPolOutZ = z; };
+  void SetMomentumIn(const TVector3& x) { SetMomentumIn(x.X(), x.Y(), x.Z()); };
+  void SetMomentumIn(float x, float y, float z) { fMomInX = x; fMomInY = y; fMomInZ = z; };
+  void SetMomentumOut(const TVector3& x) { SetMomentumOut(x.X(), x.Y(), x.Z()); };
+  void SetMomentumOut(float x, float y, float z) { fMomOutX = x; fMomOutY = y; fMomOutZ = z; };
   void SetGenGammaMultiplicity(int i) { fGenGammaMultiplicity = i; }
   void SetGenGammaIndex(int i) { fGenGammaIndex = i; }
-  int GetEvtID() { return fEvtID; };
+  Long64_t GetEvtID() { return fEvtID; };
   int GetScinID() { return fScinID; };
   int GetTrackID() { return fTrackID; };
   int GetTrackPDG() { return fTrackPDGencoding; };
   int GetNumOfInteractions() { return fNumOfInteractions; };
   float GetEneDepos() { return fEneDep; };
   float GetTime() { return fTime; };
-  TVector3 GetHitPosition() { return fPosition; };
-  TVector3 GetPolarizationIn() { return fPolarizationIn; };
-  TVector3 GetPolarizationOut() { return fPolarizationOut; };
-  TVector3 GetMomentumIn() { return fMomentumIn; };
-  TVector3 GetMomentumOut() { return fMomentumOut; };
+  //! Vectors are built from the stored components
+  TVector3 GetHitPosition() const { return TVector3(fPosX, fPosY, fPosZ); };
+  TVector3 GetPolarizationIn() const { return TVector3(fPolInX, fPolInY, fPolInZ); };
+  TVector3 GetPolarizationOut() const { return TVector3(fPolOutX, fPolOutY, fPolOutZ); };
+  TVector3 GetMomentumIn() const { return TVector3(fMomInX, fMomInY, fMomInZ); };
+  TVector3 GetMomentumOut() const { return TVector3(fMomOutX, fMomOutY, fMomOutZ); };
+  float GetHitPositionX() const { return fPosX; };
+  float GetHitPositionY() const { return fPosY; };
+  float GetHitPositionZ() const { return fPosZ; };
+  float GetPolarizationInX() const { return fPolInX; };
+  float GetPolarizationInY() const { return fPolInY; };
+  float GetPolarizationInZ() const { return fPolInZ; };
+  float GetPolarizationOutX() const { return fPolOutX; };
+  float GetPolarizationOutY() const { return fPolOutY; };
+  float GetPolarizationOutZ() const { return fPolOutZ; };
+  float GetMomentumInX() const { return fMomInX; };
+  float GetMomentumInY() const { return fMomInY; };
+  float GetMomentumInZ() const { return fMomInZ; };
+  float GetMomentumOutX() const { return fMomOutX; };
+  float GetMomentumOutY() const { return fMomOutY; };
+  float GetMomentumOutZ() const { return fMomOutZ; };
   int GetGenGammaMultiplicity() { return fGenGammaMultiplicity; }
   int GetGenGammaIndex() { return fGenGammaIndex; }
 
 private:
-  int fEvtID;
+  Long64_t fEvtID;
   int fScinID;
   int fTrackID;
   int fTrackPDGencoding;
@@ -100,13 +116,27 @@ private:
   //! with respect to the beta+ decay (start of simulation)
   float fTime;
 
-  TVector3 fPosition;
-  TVector3 fPolarizationIn;
-  TVector3 fPolarizationOut;
-  TVector3 fMomentumIn;
-  TVector3 fMomentumOut;
+  //! Since version 3 vectors are stored as float components [cm]
+  //! (versions 1-2 kept TVector3 members, converted when reading)
+  float fPosX = 0.0f;
+  float fPosY = 0.0f;
+  float fPosZ = 0.0f;
+  //! Polarization of the gamma quanta before and after the interaction
+  float fPolInX = 0.0f;
+  float fPolInY = 0.0f;
+  float fPolInZ = 0.0f;
+  float fPolOutX = 0.0f;
+  float fPolOutY = 0.0f;
+  float fPolOutZ = 0.0f;
+  //! Momentum of the gamma quanta before and after the interaction [keV]
+  float fMomInX = 0.0f;
+  float fMomInY = 0.0f;
+  float fMomInZ = 0.0f;
+  float fMomOutX = 0.0f;
+  float fMomOutY = 0.0f;
+  float fMomOutZ = 0.0f;
 
-  ClassDef(JPetGeantScinHits, 2)
+  ClassDef(JPetGeantScinHits, 4)
 };
 
 #endif /* !JPETGEANTSCINHITS_H */
@@ -15,10 +15,22 @@
 
 #include "DetectorHit.h"
 
+#include <vector>
+
+G4ThreadLocal G4Allocator<DetectorHit>* DetectorHitAllocator = nullptr;
+
+namespace
+{
+  //! Processes are created per thread, so are the tables interning them
+  G4ThreadLocal std::vector<const G4VProcess*>* internedProcesses = nullptr;
+  G4ThreadLocal std::vector<G4String>* internedProcessNames = nullptr;
+  const G4String unknownProcessName = "";
+}
+
 DetectorHit::DetectorHit() : G4VHit(), fScinID(0), fTrackID(-1), fTrackPDG(0),
 fEdep(0.0), fTime(0), fPos(0), fNumInteractions(0), fPolarizationIn(0, 0, 0),
 fPolarizationOut(0, 0, 0), fMomentumIn(0, 0, 0), fMomentumOut(0, 0, 0),
-fGenGammaMultiplicity(0), fGenGammaIndex(0) {}
+fGenGammaMultiplicity(0), fGenGammaIndex(0), fProcessID(-1) {}
 
 DetectorHit::~DetectorHit() {}
 
@@ -49,3 +61,27 @@ void DetectorHit::AddPosition(G4ThreeVector xyz, G4double weight)
 G4double DetectorHit::GetTime() { return fTime / fSumWeightTime; }
 
 G4ThreeVector DetectorHit::GetPosition() { return fPos / fSumWeightPosition; }
+
+//! Few processes define steps in the scintillators, linear search over pointers is enough
+G4int DetectorHit::InternProcess(const G4VProcess* process)
+{
+  if (!process) return -1;
+  if (!internedProcesses) {
+    internedProcesses = new std::vector<const G4VProcess*>();
+    internedProcessNames = new std::vector<G4String>();
+  }
+  for (unsigned i = 0; i < internedProcesses->size(); i++) {
+    if ((*internedProcesses)[i] == process) return i;
+  }
+  internedProcesses->push_back(process);
+  internedProcessNames->push_back(process->GetProcessName());
+  return internedProcesses->size() - 1;
+}
+
+const G4String& DetectorHit::GetInternedProcessName(G4int processID)
+{
+  if (processID < 0 || !internedProcessNames || processID >= (G4int) internedProcessNames->size()) {
+    return unknownProcessName;
+  }
+  return (*internedProcessNames)[processID];
+}
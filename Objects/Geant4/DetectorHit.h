@@ -19,6 +19,7 @@
 #include <G4THitsCollection.hh>
 #include <G4ThreeVector.hh>
 #include <G4Allocator.hh>
+#include <G4VProcess.hh>
 #include <G4Types.hh>
 #include <G4VHit.hh>
 
@@ -34,6 +35,9 @@ class DetectorHit : public G4VHit
 public:
   DetectorHit();
   virtual ~DetectorHit();
+  //! Allocated from a thread local pool, showers in the scintillators create many hits
+  inline void* operator new(size_t);
+  inline void operator delete(void* hit);
 
   void SetEdep(G4double de) { fEdep = de; }
   void SetTime(G4double val, G4double weight);
@@ -53,7 +57,7 @@ public:
   void SetPolarizationOut(G4ThreeVector xyz) { fPolarizationOut = xyz; }
   void SetMomentumIn(G4ThreeVector xyz) { fMomentumIn = xyz; }
   void SetMomentumOut(G4ThreeVector xyz) { fMomentumOut = xyz; }
-  void SetProcessName(G4String str) { fName = str; }
+  void SetProcess(const G4VProcess* process) { fProcessID = InternProcess(process); }
   void SetGenGammaMultiplicity(G4int i) { fGenGammaMultiplicity = i; }
   void SetGenGammaIndex(G4int i) { fGenGammaIndex = i; }
 
@@ -69,10 +73,15 @@ public:
   G4ThreeVector GetMomentumIn() { return fMomentumIn; }
   G4ThreeVector GetMomentumOut() { return fMomentumOut; }
   G4int GetNumInteractions() { return fNumInteractions; }
-  G4String GetProcessName() { return fName; }
+  G4int GetProcessID() { return fProcessID; }
+  const G4String& GetProcessName() { return GetInternedProcessName(fProcessID); }
   G4int GetGenGammaMultiplicity() { return fGenGammaMultiplicity; }
   G4int GetGenGammaIndex() { return fGenGammaIndex; }
 
+  //! Processes get consecutive ids in the order of their first hit in the thread
+  static G4int InternProcess(const G4VProcess* process);
+  static const G4String& GetInternedProcessName(G4int processID);
+
 private:
   //! Scintillator number (arbitrary!; not consistent with convention used in laboratory)
   G4int fScinID;
@@ -99,8 +108,8 @@ private:
   // Assigned from PrimaryParticleInformation
   G4int fGenGammaMultiplicity;
   G4int fGenGammaIndex;
-  //! process name
-  G4String fName;
+  //! Interned id of the process defining the first step, -1 if unknown
+  G4int fProcessID;
   //! Weight used for position
   G4double fSumWeightPosition;
   //! Weight used for time
@@ -109,4 +118,19 @@ private:
 
 typedef G4THitsCollection<DetectorHit> DetectorHitsCollection;
 
+extern G4ThreadLocal G4Allocator<DetectorHit>* DetectorHitAllocator;
+
+inline void* DetectorHit::operator new(size_t)
+{
+  if (!DetectorHitAllocator) {
+    DetectorHitAllocator = new G4Allocator<DetectorHit>;
+  }
+  return (void*) DetectorHitAllocator->MallocSingle();
+}
+
+inline void DetectorHit::operator delete(void* hit)
+{
+  DetectorHitAllocator->FreeSingle((DetectorHit*) hit);
+}
+
 #endif /* !DETECTORHIT_H */
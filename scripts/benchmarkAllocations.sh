@@ -0,0 +1,21 @@
+#!/bin/bash
+# Counts heap allocations per event with valgrind: the difference between runs of N and 2N events
+# removes the allocations of the initialization; run it with binaries built before and after a change
+# usage: ./benchmarkAllocations.sh [N (default: 500)] [binary (default: ./jpet_mc)] [macro (default: benchmarkAllocations.mac)]
+EVENTS=${1:-500}
+BINARY=${2:-./jpet_mc}
+MACRO=${3:-benchmarkAllocations.mac}
+
+countAllocations() {
+  settingsMacro=$(mktemp --suffix=.mac)
+  echo "/control/alias nEvents $1" > "$settingsMacro"
+  echo "/control/execute $MACRO" >> "$settingsMacro"
+  valgrind --tool=memcheck --leak-check=no "$BINARY" -t 1 "$settingsMacro" 2>&1 >/dev/null \
+    | grep "total heap usage" | awk '{gsub(",", "", $5); print $5}'
+  rm -f "$settingsMacro"
+}
+
+single=$(countAllocations "$EVENTS")
+double=$(countAllocations $((2 * EVENTS)))
+echo "Allocations: $single for $EVENTS events, $double for $((2 * EVENTS)) events"
+echo "Allocations per event: $(echo "scale=2; ($double - $single) / $EVENTS" | bc)"
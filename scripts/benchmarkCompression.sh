@@ -0,0 +1,26 @@
+#!/bin/bash
+# Reports bytes/event and output rate of benchmarkCompression.mac for several compression settings
+# usage: ./benchmarkCompression.sh [macro (default: benchmarkCompression.mac)] ["algorithm level" ...]
+MACRO=${1:-benchmarkCompression.mac}
+shift
+if [ "$#" -gt 0 ]; then
+  SETTINGS=("$@")
+else
+  SETTINGS=("zlib 1" "zlib 6" "lz4 4" "zstd 5" "zstd 9" "lzma 7")
+fi
+
+printf "%10s %6s %12s %16s %14s\n" "algorithm" "level" "bytes/event" "MB/s written" "file [MB]"
+for setting in "${SETTINGS[@]}"; do
+  read -r algorithm level <<< "$setting"
+  settingsMacro=$(mktemp --suffix=.mac)
+  echo "/jpetmc/output/compressionAlgorithm $algorithm" > "$settingsMacro"
+  echo "/jpetmc/output/compressionLevel $level" >> "$settingsMacro"
+  echo "/control/execute $MACRO" >> "$settingsMacro"
+  rm -f mcGeant.root
+  log=$(./jpet_mc "$settingsMacro" 2>/dev/null)
+  rm -f "$settingsMacro"
+  bytes=$(echo "$log" | grep "Output:" | tail -n 1 | awk '{print $5}')
+  rate=$(echo "$log" | grep "Output rate" | tail -n 1 | awk '{print $4}')
+  size=$(du -m mcGeant.root 2>/dev/null | awk '{print $1}')
+  printf "%10s %6s %12s %16s %14s\n" "$algorithm" "$level" "$bytes" "$rate" "$size"
+done
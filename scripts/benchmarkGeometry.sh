@@ -0,0 +1,31 @@
+#!/bin/bash
+# Reports geometry build time, events/s and wall time per step of benchmarkGeometry.mac
+# for several geometry settings (each setting is one or more commands separated by ';', executed before the macro)
+# usage: ./benchmarkGeometry.sh [macro (default: benchmarkGeometry.mac)] ["command[;command]" ...]
+MACRO=${1:-benchmarkGeometry.mac}
+shift
+if [ "$#" -gt 0 ]; then
+  SETTINGS=("$@")
+else
+  SETTINGS=(
+    "/jpetmc/detector/wrapping boolean"
+    "/jpetmc/detector/wrapping nested"
+    "/jpetmc/detector/wrapping nested;/jpetmc/detector/layerEnvelopes true"
+  )
+fi
+
+printf "%-70s %10s %10s %12s %10s\n" "setting" "build [ms]" "events/s" "steps" "ns/step"
+for setting in "${SETTINGS[@]}"; do
+  settingsMacro=$(mktemp --suffix=.mac)
+  echo "$setting" | tr ';' '\n' > "$settingsMacro"
+  echo "/control/execute $MACRO" >> "$settingsMacro"
+  rm -f mcGeant.root mcGeant_metrics.json
+  log=$(./jpet_mc "$settingsMacro" 2>/dev/null)
+  rm -f "$settingsMacro"
+  build=$(echo "$log" | grep "Geometry constructed" | tail -n 1 | awk '{print $5}')
+  rate=$(grep '"eventsPerSecond"' mcGeant_metrics.json | tr -d ' ,' | cut -d: -f2)
+  steps=$(grep '"steps"' mcGeant_metrics.json | tr -d ' ,' | cut -d: -f2)
+  wallTime=$(grep '"wallTime"' mcGeant_metrics.json | tr -d ' ,' | cut -d: -f2)
+  nsPerStep=$(awk -v t="$wallTime" -v n="$steps" 'BEGIN { if (n > 0) printf "%.1f", 1e9 * t / n }')
+  printf "%-70s %10s %10s %12s %10s\n" "$setting" "$build" "$rate" "$steps" "$nsPerStep"
+done
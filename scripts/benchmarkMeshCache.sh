@@ -0,0 +1,25 @@
+#!/bin/bash
+# Reports startup time of benchmarkMeshCache.mac without the mesh cache, with an empty cache
+# (STL parsed and cache written) and with the cache filled by the previous run
+# usage: ./benchmarkMeshCache.sh [macro (default: benchmarkMeshCache.mac)]
+MACRO=${1:-benchmarkMeshCache.mac}
+CACHE_DIR=$(mktemp -d)
+
+printf "%-10s %14s %14s\n" "cache" "meshes [ms]" "startup [s]"
+for setting in off cold warm; do
+  settingsMacro=$(mktemp --suffix=.mac)
+  if [ "$setting" == "off" ]; then
+    echo "/jpetmc/detector/meshCache false" > "$settingsMacro"
+  else
+    echo "/jpetmc/detector/meshCacheDirectory $CACHE_DIR" > "$settingsMacro"
+  fi
+  echo "/control/execute $MACRO" >> "$settingsMacro"
+  start=$(date +%s.%N)
+  log=$(./jpet_mc "$settingsMacro" 2>/dev/null)
+  end=$(date +%s.%N)
+  rm -f "$settingsMacro"
+  meshes=$(echo "$log" | grep "^----> Mesh" | awk '{sum += $(NF - 1)} END {print sum}')
+  startup=$(awk -v a="$start" -v b="$end" 'BEGIN {printf "%.2f", b - a}')
+  printf "%-10s %14s %14s\n" "$setting" "$meshes" "$startup"
+done
+rm -rf "$CACHE_DIR"
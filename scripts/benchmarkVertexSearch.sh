@@ -0,0 +1,15 @@
+#!/bin/bash
+# Generates big chamber events with the boundary traversal and the fixed step walk of the vertex search,
+# reports navigator locates per vertex; with the same seed both outputs contain the same vertices
+# usage: ./benchmarkVertexSearch.sh [macro (default: benchmarkVertexSearch.mac)]
+MACRO=${1:-benchmarkVertexSearch.mac}
+
+for search in boundary fixedStep; do
+  settingsMacro=$(mktemp --suffix=.mac)
+  echo "/jpetmc/run/vertexSearch $search" > "$settingsMacro"
+  echo "/control/execute $MACRO" >> "$settingsMacro"
+  rm -f mcGeant.root
+  ./jpet_mc "$settingsMacro" 2>/dev/null | grep -E "Vertex search|----> Run"
+  rm -f "$settingsMacro"
+  mv mcGeant.root "vertexSearch_$search.root"
+done
@@ -0,0 +1,23 @@
+#!/bin/bash
+# Simulates validateFrameModel.mac with the CAD frame as a single mesh and split into bodies,
+# reports events/s and wall time per step and compares the hit spectra of both outputs
+# usage: ./compareFrameModel.sh [macro (default: validateFrameModel.mac)]
+MACRO=${1:-validateFrameModel.mac}
+
+printf "%-8s %10s %12s %10s\n" "model" "events/s" "steps" "ns/step"
+for model in mesh bodies; do
+  settingsMacro=$(mktemp --suffix=.mac)
+  echo "/jpetmc/detector/frameModel $model" > "$settingsMacro"
+  echo "/control/execute $MACRO" >> "$settingsMacro"
+  rm -f mcGeant.root mcGeant_metrics.json
+  ./jpet_mc "$settingsMacro" > /dev/null 2>&1
+  rm -f "$settingsMacro"
+  rate=$(grep '"eventsPerSecond"' mcGeant_metrics.json | tr -d ' ,' | cut -d: -f2)
+  steps=$(grep '"steps"' mcGeant_metrics.json | tr -d ' ,' | cut -d: -f2)
+  wallTime=$(grep '"wallTime"' mcGeant_metrics.json | tr -d ' ,' | cut -d: -f2)
+  nsPerStep=$(awk -v t="$wallTime" -v n="$steps" 'BEGIN { if (n > 0) printf "%.1f", 1e9 * t / n }')
+  printf "%-8s %10s %12s %10s\n" "$model" "$rate" "$steps" "$nsPerStep"
+  mv mcGeant.root "frameModel_$model.root"
+done
+
+root -l -b -q "compareFrameModel.C(\"frameModel_mesh.root\", \"frameModel_bodies.root\")"
@@ -0,0 +1,17 @@
+#!/bin/bash
+# Generates 3g events with the tabulated and the TGenPhaseSpace sampler, reports vertices/s
+# and compares the generated energy and angle histograms of both outputs
+# usage: ./compareThreeGammaSampler.sh [macro (default: benchmarkThreeGamma.mac)]
+MACRO=${1:-benchmarkThreeGamma.mac}
+
+for sampler in table phaseSpace; do
+  settingsMacro=$(mktemp --suffix=.mac)
+  echo "/jpetmc/source/threeGammaSampler $sampler" > "$settingsMacro"
+  echo "/control/execute $MACRO" >> "$settingsMacro"
+  rm -f mcGeant.root
+  ./jpet_mc "$settingsMacro" 2>/dev/null | grep "3g vertices"
+  rm -f "$settingsMacro"
+  mv mcGeant.root "threeGamma_$sampler.root"
+done
+
+root -l -b -q "compareThreeGammaSampler.C(\"threeGamma_table.root\", \"threeGamma_phaseSpace.root\")"
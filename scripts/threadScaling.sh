@@ -0,0 +1,19 @@
+#!/bin/bash
+# Reports events/s of benchmarkThreads.mac for 1, 2, 4, ... up to N threads
+# usage: ./threadScaling.sh [N (default: number of cores)] [macro (default: benchmarkThreads.mac)]
+MAX_THREADS=${1:-$(nproc)}
+MACRO=${2:-benchmarkThreads.mac}
+
+printf "%8s %14s %20s\n" "threads" "events/s" "events/s per thread"
+threads=1
+while [ "$threads" -le "$MAX_THREADS" ]; do
+  line=$(./jpet_mc -t "$threads" "$MACRO" 2>/dev/null | grep "Throughput" | tail -n 1)
+  rate=$(echo "$line" | awk '{print $3}')
+  perThread=$(echo "$line" | awk '{print $5}')
+  printf "%8s %14s %20s\n" "$threads" "$rate" "$perThread"
+  if [ "$threads" -lt "$MAX_THREADS" ] && [ $((threads * 2)) -gt "$MAX_THREADS" ]; then
+    threads=$MAX_THREADS
+  else
+    threads=$((threads * 2))
+  fi
+done